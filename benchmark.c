@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200809L   // nanosleep
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -5,20 +7,15 @@
 #include <math.h>
 #include <omp.h>
 
-#include "mcts.h"
-
-typedef enum {
-    MCTS_SEQUENTIAL,
-    MCTS_LEAF_PARALLEL,
-    MCTS_ROOT_PARALLEL,
-    MCTS_ROOT_PARALLEL_VIRTUAL_LOSS
-} MCTSMode;
+#include "mcts_engine.h"
+#include "mcts_service.h"
 
 const char* mode_names[] = {
     "Sequential",
     "Leaf Parallel",
     "Root Parallel",
-    "Root Parallel + Virtual Loss"
+    "Root Parallel + Virtual Loss",
+    "Root Parallel + Sync"
 };
 
 typedef struct {
@@ -27,79 +24,40 @@ typedef struct {
     int draws;
     double total_time;
     int move_count;
+    long reused_visits;
     MCTSTimingAggregator agg;
 } ModeStats;
 
-int get_random_move(GameState *state, int *r, int *c) {
-    int board_size = SIZE * SIZE;
-    int moves[board_size][2], count = 0;
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            if (is_valid_move(state, i, j)) {
-                moves[count][0] = i;
-                moves[count][1] = j;
-                count++;
-            }
-    
-    if (count == 0) return 0;
-    int idx = rand() % count;
-    *r = moves[idx][0];
-    *c = moves[idx][1];
+static RNG bench_rng;
+static MCTSEngine bench_engines[2];  // One engine per seat, both on bench_tasks
+static TaskPool bench_tasks;         // Workers for every parallel mode, kept for the whole run
+
+int get_random_move(GameState *state, int *r, int *c, RNG *rng) {
+    MoveList moves;
+    if (generate_moves(state, &moves) == 0) return 0;
+    int sq = moves.squares[rng_bounded(rng, moves.count)];
+    *r = sq / SIZE;
+    *c = sq % SIZE;
     return 1;
 }
 
-int get_mcts_move(GameState *state, int simulations, int *r, int *c, 
-                  MCTSMode mode, MCTSTiming *timing_out) {
-    Node *root = create_node(state, -1, -1, NULL);
-    root->player_just_moved = opponent(state->player);
-    expand(root);
-
-    if (root->num_children == 0) {
-        free_tree(root);
-        return 0;
-    }
-
-    MCTSTiming timing;
-    switch (mode) {
-        case MCTS_SEQUENTIAL:
-            timing = mcts_sequential(root, simulations);
-            break;
-        case MCTS_LEAF_PARALLEL:
-            timing = mcts_leaf_parallel(root, simulations);
-            break;
-        case MCTS_ROOT_PARALLEL:
-            timing = mcts_root_parallel(root, simulations);
-            break;
-        case MCTS_ROOT_PARALLEL_VIRTUAL_LOSS:
-            timing = mcts_root_parallel_virtual_loss(root, simulations);
-            break;
-        default:
-            timing = mcts_sequential(root, simulations);
-            break;
-    }
+int get_mcts_move(MCTSEngine *engine, GameState *state, const SearchLimits *limits, int *r, int *c,
+                  MCTSMode mode, MCTSTiming *timing_out, int *reused_out) {
+    engine->config.mode = mode;
+    MCTSResult result;
+    int found = mcts_engine_search(engine, state, limits, &result);
 
     if (timing_out != NULL) {
-        *timing_out = timing;
+        *timing_out = result.timing;
     }
-
-    Node *best = NULL;
-    double best_winrate = -1.0;
-    for (int i = 0; i < root->num_children; i++) {
-        if (root->children[i]->visits > 0) {
-            double winrate = root->children[i]->wins / root->children[i]->visits;
-            if (winrate > best_winrate) {
-                best_winrate = winrate;
-                best = root->children[i];
-            }
-        }
+    if (reused_out != NULL) {
+        *reused_out = result.reused;
     }
-
-    if (best) {
-        *r = best->move_row;
-        *c = best->move_col;
+    if (found) {
+        *r = result.move / SIZE;
+        *c = result.move % SIZE;
     }
-    free_tree(root);
-    return best != NULL;
+    return found;
 }
 
 // Benchmark 1: All modes vs random player
@@ -107,43 +65,48 @@ void benchmark_all_modes_vs_random(int mcts_sims, int num_games) {
     printf("\n=== Benchmark 1: All MCTS Modes vs Random Player (%d sims, %d games) ===\n", 
            mcts_sims, num_games);
 
-    ModeStats stats[4];
+    SearchLimits limits = search_iterations(mcts_sims);
+    ModeStats stats[NUM_MODES];
     
     // Initialize all stats
-    for (int mode = 0; mode < 4; mode++) {
+    for (int mode = 0; mode < NUM_MODES; mode++) {
         stats[mode].wins = 0;
         stats[mode].draws = 0;
         stats[mode].total_time = 0.0;
         stats[mode].move_count = 0;
+        stats[mode].reused_visits = 0;
         init_timing_aggregator(&stats[mode].agg);
     }
     
     // Test each mode
-    for (int mode = 0; mode < 4; mode++) {
+    for (int mode = 0; mode < NUM_MODES; mode++) {
         printf("\nTesting %s MCTS...\n", mode_names[mode]);
         
         for (int game = 0; game < num_games; game++) {
             GameState state;
             init_board(&state);
+            mcts_engine_new_game(&bench_engines[0], &state);
             int mcts_player = (game % 2 == 0) ? BLACK : WHITE;
             
             while (1) {
                 if (!has_valid_moves(&state)) {
-                    state.player = opponent(state.player);
+                    pass_turn(&state);
                     if (!has_valid_moves(&state)) break;
                 }
                 
                 int r, c;
                 if (state.player == mcts_player) {
                     MCTSTiming timing;
+                    int reused;
                     double start = omp_get_wtime();
-                    int res = get_mcts_move(&state, mcts_sims, &r, &c, mode, &timing);
+                    int res = get_mcts_move(&bench_engines[0], &state, &limits, &r, &c, mode, &timing, &reused);
                     add_timing(&stats[mode].agg, &timing);
                     if (!res) break;
+                    stats[mode].reused_visits += reused;
                     stats[mode].total_time += (omp_get_wtime() - start);
                     stats[mode].move_count++;
                 } else {
-                    if (!get_random_move(&state, &r, &c)) break;
+                    if (!get_random_move(&state, &r, &c, &bench_rng)) break;
                 }
                 make_move(&state, r, c);
             }
@@ -172,7 +135,7 @@ void benchmark_all_modes_vs_random(int mcts_sims, int num_games) {
     
     double baseline_time = stats[0].total_time / stats[0].move_count;
     
-    for (int mode = 0; mode < 4; mode++) {
+    for (int mode = 0; mode < NUM_MODES; mode++) {
         int losses = num_games - stats[mode].wins - stats[mode].draws;
         double win_rate = 100.0 * stats[mode].wins / num_games;
         double avg_time = stats[mode].total_time / stats[mode].move_count;
@@ -186,8 +149,14 @@ void benchmark_all_modes_vs_random(int mcts_sims, int num_games) {
                avg_time);
     }
     
+    printf("\nAverage visits reused from the previous search:\n");
+    for (int mode = 0; mode < NUM_MODES; mode++) {
+        printf("  %s: %.1f\n", mode_names[mode],
+               (double)stats[mode].reused_visits / stats[mode].move_count);
+    }
+
     printf("\nSpeedup vs Sequential:\n");
-    for (int mode = 1; mode < 4; mode++) {
+    for (int mode = 1; mode < NUM_MODES; mode++) {
         double avg_time = stats[mode].total_time / stats[mode].move_count;
         double speedup = baseline_time / avg_time;
         printf("  %s: %.2fx\n", mode_names[mode], speedup);
@@ -199,6 +168,7 @@ void benchmark_head_to_head_all_modes(int simulations, int num_games) {
     printf("\n=== Benchmark 2: Head-to-Head All Modes (%d sims, %d games each matchup) ===\n",
            simulations, num_games);
 
+    SearchLimits limits = search_iterations(simulations);
     typedef struct {
         int mode1_wins;
         int mode2_wins;
@@ -211,11 +181,11 @@ void benchmark_head_to_head_all_modes(int simulations, int num_games) {
         MCTSTimingAggregator mode2_agg;
     } MatchupStats;
 
-    MatchupStats matchups[4][4];
+    MatchupStats matchups[NUM_MODES][NUM_MODES];
 
     // Initialize stats
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
+    for (int i = 0; i < NUM_MODES; i++) {
+        for (int j = 0; j < NUM_MODES; j++) {
             matchups[i][j].mode1_wins = 0;
             matchups[i][j].mode2_wins = 0;
             matchups[i][j].draws = 0;
@@ -229,20 +199,22 @@ void benchmark_head_to_head_all_modes(int simulations, int num_games) {
     }
 
     // Run matchups (only upper triangle to avoid duplicates)
-    for (int mode1 = 0; mode1 < 4; mode1++) {
-        for (int mode2 = mode1 + 1; mode2 < 4; mode2++) {
+    for (int mode1 = 0; mode1 < NUM_MODES; mode1++) {
+        for (int mode2 = mode1 + 1; mode2 < NUM_MODES; mode2++) {
             printf("\nTesting %s vs %s...\n", mode_names[mode1], mode_names[mode2]);
 
             for (int game = 0; game < num_games; game++) {
                 GameState state;
                 init_board(&state);
+                mcts_engine_new_game(&bench_engines[0], &state);
+                mcts_engine_new_game(&bench_engines[1], &state);
 
                 int player1 = (game % 2 == 0) ? BLACK : WHITE;
                 int player2 = opponent(player1);
 
                 while (1) {
                     if (!has_valid_moves(&state)) {
-                        state.player = opponent(state.player);
+                        pass_turn(&state);
                         if (!has_valid_moves(&state)) break;
                     }
 
@@ -254,7 +226,7 @@ void benchmark_head_to_head_all_modes(int simulations, int num_games) {
                         // CRITICAL: Ensure threads from previous move are done
                         #pragma omp barrier
                         
-                        int res = get_mcts_move(&state, simulations, &r, &c, mode1, &timing);
+                        int res = get_mcts_move(&bench_engines[0], &state, &limits, &r, &c, mode1, &timing, NULL);
                         add_timing(&matchups[mode1][mode2].mode1_agg, &timing);
                         if (!res) break;
                         matchups[mode1][mode2].mode1_total_time += (omp_get_wtime() - start);
@@ -263,7 +235,7 @@ void benchmark_head_to_head_all_modes(int simulations, int num_games) {
                         // CRITICAL: Ensure threads from previous move are done
                         #pragma omp barrier
                         
-                        int res = get_mcts_move(&state, simulations, &r, &c, mode2, &timing);
+                        int res = get_mcts_move(&bench_engines[1], &state, &limits, &r, &c, mode2, &timing, NULL);
                         add_timing(&matchups[mode1][mode2].mode2_agg, &timing);
                         if (!res) break;
                         matchups[mode1][mode2].mode2_total_time += (omp_get_wtime() - start);
@@ -300,8 +272,8 @@ void benchmark_head_to_head_all_modes(int simulations, int num_games) {
     printf("║                    HEAD-TO-HEAD RESULTS                            ║\n");
     printf("╚════════════════════════════════════════════════════════════════════╝\n");
 
-    for (int mode1 = 0; mode1 < 4; mode1++) {
-        for (int mode2 = mode1 + 1; mode2 < 4; mode2++) {
+    for (int mode1 = 0; mode1 < NUM_MODES; mode1++) {
+        for (int mode2 = mode1 + 1; mode2 < NUM_MODES; mode2++) {
             printf("\n%s vs %s:\n", mode_names[mode1], mode_names[mode2]);
             printf("  %s: %d wins, %d losses, %d draws (%.1f%% win rate)\n",
                    mode_names[mode1],
@@ -335,11 +307,13 @@ void benchmark_thread_scaling(int simulations, int num_games) {
     printf("\n=== Benchmark 3: Thread Scaling for Parallel Modes (%d sims, %d games) ===\n",
            simulations, num_games);
     
-    int thread_counts[] = {1, 2, 4, 8};
+    SearchLimits limits = search_iterations(simulations);
+    int thread_counts[] = {1, 2, 4, 8, 16, 32};
     int num_configs = sizeof(thread_counts) / sizeof(thread_counts[0]);
+    int default_threads = task_pool_size(&bench_tasks);
     
     // Test each parallel mode
-    for (int mode = 1; mode < 4; mode++) {
+    for (int mode = 1; mode < NUM_MODES; mode++) {
         printf("\n%s:\n", mode_names[mode]);
         printf("%-8s | %-12s | %-10s | %-12s\n", "Threads", "Time/Move", "Speedup", "Efficiency");
         printf("---------|--------------|------------|-------------\n");
@@ -348,7 +322,8 @@ void benchmark_thread_scaling(int simulations, int num_games) {
         
         for (int cfg = 0; cfg < num_configs; cfg++) {
             int threads = thread_counts[cfg];
-            omp_set_num_threads(threads);
+            task_pool_destroy(&bench_tasks);
+            task_pool_init(&bench_tasks, threads);
             
             MCTSTimingAggregator agg;
             init_timing_aggregator(&agg);
@@ -359,17 +334,18 @@ void benchmark_thread_scaling(int simulations, int num_games) {
             for (int game = 0; game < num_games; game++) {
                 GameState state;
                 init_board(&state);
+                mcts_engine_new_game(&bench_engines[0], &state);
                 
                 while (1) {
                     if (!has_valid_moves(&state)) {
-                        state.player = opponent(state.player);
+                        pass_turn(&state);
                         if (!has_valid_moves(&state)) break;
                     }
                     
                     int r, c;
                     MCTSTiming timing;
                     double start = omp_get_wtime();
-                    int res = get_mcts_move(&state, simulations, &r, &c, mode, &timing);
+                    int res = get_mcts_move(&bench_engines[0], &state, &limits, &r, &c, mode, &timing, NULL);
                     add_timing(&agg, &timing);
                     if (!res) break;
                     total_time += (omp_get_wtime() - start);
@@ -389,6 +365,9 @@ void benchmark_thread_scaling(int simulations, int num_games) {
                    threads, avg_time, speedup, efficiency);
         }
     }
+
+    task_pool_destroy(&bench_tasks);
+    task_pool_init(&bench_tasks, default_threads);
 }
 
 // Benchmark 4: simulation scaling for all modes
@@ -399,25 +378,26 @@ void benchmark_simulation_scaling(int num_games) {
     int num_configs = sizeof(sim_counts) / sizeof(sim_counts[0]);
     
     printf("\n%-8s | ", "Sims");
-    for (int mode = 0; mode < 4; mode++) {
+    for (int mode = 0; mode < NUM_MODES; mode++) {
         printf("%-18s | ", mode_names[mode]);
     }
     printf("\n");
     
     printf("---------|");
-    for (int mode = 0; mode < 4; mode++) {
+    for (int mode = 0; mode < NUM_MODES; mode++) {
         printf("--------------------|");
     }
     printf("\n");
     
     printf("%-8s | ", "");
-    for (int mode = 0; mode < 4; mode++) {
+    for (int mode = 0; mode < NUM_MODES; mode++) {
         printf("%-8s | %-7s | ", "Time", "Wins");
     }
     printf("\n");
 
     for (int cfg = 0; cfg < num_configs; cfg++) {
         int sims = sim_counts[cfg];
+        SearchLimits limits = search_iterations(sims);
         
         typedef struct {
             double time;
@@ -426,8 +406,8 @@ void benchmark_simulation_scaling(int num_games) {
             MCTSTimingAggregator agg;
         } ModeResult;
         
-        ModeResult results[4];
-        for (int mode = 0; mode < 4; mode++) {
+        ModeResult results[NUM_MODES];
+        for (int mode = 0; mode < NUM_MODES; mode++) {
             results[mode].time = 0.0;
             results[mode].moves = 0;
             results[mode].wins = 0;
@@ -435,15 +415,16 @@ void benchmark_simulation_scaling(int num_games) {
         }
         
         // Test each mode
-        for (int mode = 0; mode < 4; mode++) {
+        for (int mode = 0; mode < NUM_MODES; mode++) {
             for (int game = 0; game < num_games; game++) {
                 GameState state;
                 init_board(&state);
+                mcts_engine_new_game(&bench_engines[0], &state);
                 int mcts_player = (game % 2 == 0) ? BLACK : WHITE;
                 
                 while (1) {
                     if (!has_valid_moves(&state)) {
-                        state.player = opponent(state.player);
+                        pass_turn(&state);
                         if (!has_valid_moves(&state)) break;
                     }
                     
@@ -451,13 +432,13 @@ void benchmark_simulation_scaling(int num_games) {
                     if (state.player == mcts_player) {
                         MCTSTiming timing;
                         double start = omp_get_wtime();
-                        int res = get_mcts_move(&state, sims, &r, &c, mode, &timing);
+                        int res = get_mcts_move(&bench_engines[0], &state, &limits, &r, &c, mode, &timing, NULL);
                         add_timing(&results[mode].agg, &timing);
                         if (!res) break;
                         results[mode].time += (omp_get_wtime() - start);
                         results[mode].moves++;
                     } else {
-                        if (!get_random_move(&state, &r, &c)) break;
+                        if (!get_random_move(&state, &r, &c, &bench_rng)) break;
                     }
                     make_move(&state, r, c);
                 }
@@ -468,7 +449,7 @@ void benchmark_simulation_scaling(int num_games) {
         }
         
         printf("%-8d | ", sims);
-        for (int mode = 0; mode < 4; mode++) {
+        for (int mode = 0; mode < NUM_MODES; mode++) {
             double avg_time = results[mode].time / results[mode].moves;
             printf("%7.4fs | %3d/%3d | ", avg_time, results[mode].wins, num_games);
         }
@@ -476,14 +457,186 @@ void benchmark_simulation_scaling(int num_games) {
     }
 }
 
+// Benchmark 5: fixed time per move, with and without early termination
+void benchmark_time_budget(double seconds, int num_games) {
+    printf("\n=== Benchmark 5: Time Budget All Modes (%.0f ms/move, %d games each) ===\n",
+           seconds * 1000.0, num_games);
+
+    printf("\n%-30s | %-10s | %10s | %12s | %7s\n",
+           "Mode", "Stop", "Time/Move", "Playouts/Mv", "Wins");
+    printf("-------------------------------|------------|------------|--------------|--------\n");
+
+    for (int mode = 0; mode < NUM_MODES; mode++) {
+        for (int early_stop = 0; early_stop <= 1; early_stop++) {
+            SearchLimits limits = {0, seconds, early_stop, NULL};
+            double total_time = 0.0;
+            long playouts = 0;
+            int moves = 0, wins = 0;
+
+            for (int game = 0; game < num_games; game++) {
+                GameState state;
+                init_board(&state);
+                mcts_engine_new_game(&bench_engines[0], &state);
+                int mcts_player = (game % 2 == 0) ? BLACK : WHITE;
+
+                while (1) {
+                    if (!has_valid_moves(&state)) {
+                        pass_turn(&state);
+                        if (!has_valid_moves(&state)) break;
+                    }
+
+                    int r, c;
+                    if (state.player == mcts_player) {
+                        MCTSTiming timing;
+                        double start = omp_get_wtime();
+                        int res = get_mcts_move(&bench_engines[0], &state, &limits, &r, &c, mode, &timing, NULL);
+                        if (!res) break;
+                        total_time += (omp_get_wtime() - start);
+                        playouts += timing.iterations;
+                        moves++;
+                    } else {
+                        if (!get_random_move(&state, &r, &c, &bench_rng)) break;
+                    }
+                    make_move(&state, r, c);
+                }
+
+                if (get_winner(&state) == mcts_player) wins++;
+            }
+
+            printf("%-30s | %-10s | %8.2f ms | %12.0f | %3d/%3d\n",
+                   early_stop ? "" : mode_names[mode],
+                   early_stop ? "early" : "deadline",
+                   1000.0 * total_time / moves, (double)playouts / moves,
+                   wins, num_games);
+        }
+    }
+}
+
+// Benchmark 6: pondering on the opponent's time. The opponent is a random
+// player that takes the same time per move as we do.
+void benchmark_pondering(double seconds, int num_games) {
+    printf("\n=== Benchmark 6: Pondering, %s (%.0f ms/move, %d games each) ===\n",
+           mode_names[MCTS_ROOT_PARALLEL_VIRTUAL_LOSS], seconds * 1000.0, num_games);
+
+    printf("\n%-10s | %10s | %12s | %14s | %7s\n",
+           "Ponder", "Time/Move", "Handoff", "Reused Visits", "Wins");
+    printf("-----------|------------|--------------|----------------|--------\n");
+
+    SearchLimits move_limits = {0, seconds, 0, NULL};
+    SearchLimits ponder_limits = {0, 10.0 * seconds, 0, NULL};
+    struct timespec think = {(time_t)seconds, (long)((seconds - (time_t)seconds) * 1e9)};
+
+    for (int use_ponder = 0; use_ponder <= 1; use_ponder++) {
+        double total_time = 0.0, handoff_time = 0.0;
+        long reused_visits = 0;
+        int moves = 0, wins = 0;
+
+        for (int game = 0; game < num_games; game++) {
+            GameState state;
+            init_board(&state);
+            mcts_engine_new_game(&bench_engines[0], &state);
+            int mcts_player = (game % 2 == 0) ? BLACK : WHITE;
+
+            while (1) {
+                if (!has_valid_moves(&state)) {
+                    pass_turn(&state);
+                    if (!has_valid_moves(&state)) break;
+                }
+
+                int r, c;
+                if (state.player == mcts_player) {
+                    double start = omp_get_wtime();
+                    if (use_ponder) {
+                        mcts_engine_stop(&bench_engines[0]);
+                        handoff_time += omp_get_wtime() - start;
+                    }
+
+                    MCTSTiming timing;
+                    int reused;
+                    int res = get_mcts_move(&bench_engines[0], &state, &move_limits, &r, &c,
+                                            MCTS_ROOT_PARALLEL_VIRTUAL_LOSS, &timing, &reused);
+                    if (!res) break;
+                    total_time += (omp_get_wtime() - start);
+                    reused_visits += reused;
+                    moves++;
+
+                    make_move(&state, r, c);
+                    if (use_ponder) mcts_engine_ponder(&bench_engines[0], &state, &ponder_limits);
+                } else {
+                    nanosleep(&think, NULL);
+                    if (!get_random_move(&state, &r, &c, &bench_rng)) break;
+                    make_move(&state, r, c);
+                }
+            }
+            mcts_engine_stop(&bench_engines[0]);
+
+            if (get_winner(&state) == mcts_player) wins++;
+        }
+
+        printf("%-10s | %8.2f ms | %9.3f ms | %14.1f | %3d/%3d\n",
+               use_ponder ? "on" : "off",
+               1000.0 * total_time / moves, 1000.0 * handoff_time / moves,
+               (double)reused_visits / moves, wins, num_games);
+    }
+}
+
+// Benchmark 7: many concurrent self-play games on one shared pool
+void benchmark_multi_game(int iterations, int num_games) {
+    printf("\n=== Benchmark 7: Multi-Game Service (%d sims/move, %d self-play games) ===\n",
+           iterations, num_games);
+    printf("\n%-30s | %-8s | %10s | %9s | %9s | %9s | %9s\n",
+           "Per-Game Mode", "Threads", "Moves/s", "Games/s", "p50 ms", "p90 ms", "p99 ms");
+    printf("-------------------------------|----------|------------|-----------|-----------|-----------|----------\n");
+
+    int thread_counts[] = {1, 2, 4, 8};
+    int num_configs = sizeof(thread_counts) / sizeof(thread_counts[0]);
+    MCTSMode modes[] = {MCTS_SEQUENTIAL, MCTS_ROOT_PARALLEL_VIRTUAL_LOSS};
+    SearchLimits limits = search_iterations(iterations);
+
+    for (int m = 0; m < 2; m++) {
+        for (int cfg = 0; cfg < num_configs; cfg++) {
+            TaskPool tasks;
+            task_pool_init(&tasks, thread_counts[cfg]);
+            MCTSConfig config;
+            mcts_config_default(&config);
+            config.mode = modes[m];
+            config.tt_bytes = TT_DEFAULT_BYTES / 16;
+            config.seed = rng_next(&bench_rng);
+
+            SearchService service;
+            ServiceReport report;
+            service_init(&service, &tasks, num_games, &config, &limits);
+            service_play(&service, &report);
+            service_destroy(&service);
+            task_pool_destroy(&tasks);
+
+            printf("%-30s | %-8d | %10.1f | %9.2f | %9.2f | %9.2f | %9.2f\n",
+                   cfg == 0 ? mode_names[modes[m]] : "", thread_counts[cfg],
+                   report.moves_per_sec, report.games_per_sec, report.latency_p50 * 1000.0,
+                   report.latency_p90 * 1000.0, report.latency_p99 * 1000.0);
+        }
+    }
+}
+
 int main(int argc, char *argv[]) {
-    srand(time(NULL));
+    // Optional second argument fixes the RNG seed for reproducible runs
+    uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : (uint64_t)time(NULL);
+    rng_seed(&bench_rng, seed);
+
+    task_pool_init(&bench_tasks, omp_get_max_threads());
+    MCTSConfig config;
+    mcts_config_default(&config);
+    for (int seat = 0; seat < 2; seat++) {
+        config.seed = seed + seat + 1;
+        mcts_engine_init(&bench_engines[seat], &config, &bench_tasks);
+    }
     
     printf("╔════════════════════════════════════════════════╗\n");
     printf("║  Othello MCTS: All Modes Comparison            ║\n");
     printf("╚════════════════════════════════════════════════╝\n");
+    printf("\nRNG seed: %llu\n", (unsigned long long)seed);
     printf("\nModes tested:\n");
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < NUM_MODES; i++) {
         printf("  %d. %s\n", i, mode_names[i]);
     }
     
@@ -493,23 +646,35 @@ int main(int argc, char *argv[]) {
         benchmark_head_to_head_all_modes(1000, 10);
         benchmark_thread_scaling(1000, 5);
         benchmark_simulation_scaling(10);
+        benchmark_time_budget(0.02, 4);
+        benchmark_pondering(0.02, 4);
+        benchmark_multi_game(500, 16);
     } else if (argc > 1 && strcmp(argv[1], "full") == 0) {
         printf("\n[FULL MODE - Comprehensive testing]\n");
         benchmark_all_modes_vs_random(2000, 50);
         benchmark_head_to_head_all_modes(2000, 30);
         benchmark_thread_scaling(2000, 15);
         benchmark_simulation_scaling(30);
+        benchmark_time_budget(0.1, 10);
+        benchmark_pondering(0.1, 10);
+        benchmark_multi_game(2000, 64);
     } else {
         printf("\n[STANDARD MODE]\n");
         benchmark_all_modes_vs_random(1000, 30);
         benchmark_head_to_head_all_modes(1000, 20);
         benchmark_thread_scaling(1000, 10);
         benchmark_simulation_scaling(15);
+        benchmark_time_budget(0.05, 6);
+        benchmark_pondering(0.05, 6);
+        benchmark_multi_game(1000, 32);
     }
     
     printf("\n╔════════════════════════════════════════════════╗\n");
     printf("║  Benchmark Complete!                           ║\n");
     printf("╚════════════════════════════════════════════════╝\n");
-    
+
+    mcts_engine_destroy(&bench_engines[0]);
+    mcts_engine_destroy(&bench_engines[1]);
+    task_pool_destroy(&bench_tasks);
     return 0;
 }
\ No newline at end of file
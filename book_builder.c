@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "mcts_engine.h"
+
+// Offline opening book builder. Enumerates every position reachable in the
+// first N plies, folds symmetric positions together, searches each one
+// deeply and writes the best replies as a sorted book file for
+// mcts_server --book.
+//
+//   book_builder --plies 6 --iterations 50000 --out book.bin
+
+#define DEFAULT_PLIES 6
+#define DEFAULT_ITERATIONS 50000
+
+typedef struct {
+    GameState *states;
+    size_t count;
+    size_t capacity;
+} PositionList;
+
+static int push_position(PositionList *list, const GameState *state) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 64;
+        GameState *states = realloc(list->states, capacity * sizeof(GameState));
+        if (states == NULL) return 0;
+        list->states = states;
+        list->capacity = capacity;
+    }
+    list->states[list->count++] = *state;
+    return 1;
+}
+
+static int compare_positions(const void *a, const void *b) {
+    uint64_t ka = ((const GameState *)a)->hash, kb = ((const GameState *)b)->hash;
+    return (ka > kb) - (ka < kb);
+}
+
+// Sort by key and drop repeats
+static void unique_positions(PositionList *list) {
+    qsort(list->states, list->count, sizeof(GameState), compare_positions);
+    size_t kept = 0;
+    for (size_t i = 0; i < list->count; i++)
+        if (kept == 0 || list->states[kept - 1].hash != list->states[i].hash)
+            list->states[kept++] = list->states[i];
+    list->count = kept;
+}
+
+// Canonical successors of every position in from. A side without moves
+// passes; finished games have none.
+static int next_ply(const PositionList *from, PositionList *to) {
+    to->count = 0;
+    for (size_t i = 0; i < from->count; i++) {
+        GameState state = from->states[i], child, canonical;
+        MoveList moves;
+        if (generate_moves_or_pass(&state, &moves) == 0) continue;
+        for (int m = 0; m < moves.count; m++) {
+            child = state;
+            make_move_square(&child, moves.squares[m]);
+            book_canonical(&child, &canonical);
+            if (!push_position(to, &canonical)) return 0;
+        }
+    }
+    unique_positions(to);
+    return 1;
+}
+
+typedef struct {
+    MCTSEngine *engines;    // One per pool worker
+    const GameState *positions;
+    const int *plies;
+    BookEntry *entries;
+    SearchLimits limits;
+    int done;
+    int total;
+} BuildJob;
+
+static void build_task(void *arg, int index, int worker) {
+    BuildJob *job = arg;
+    MCTSEngine *engine = &job->engines[worker];
+    const GameState *state = &job->positions[index];
+    BookEntry *entry = &job->entries[index];
+    MCTSResult result;
+
+    mcts_engine_new_game(engine, state);
+    memset(entry, 0, sizeof(*entry));
+    entry->key = state->hash;
+    entry->ply = job->plies[index];
+    if (mcts_engine_search(engine, state, &job->limits, &result)) {
+        entry->move = result.move;
+        entry->visits = result.visits;
+        entry->value = (uint16_t)(result.win_rate * 65535.0 + 0.5);
+    } else {
+        entry->visits = 0;   // Nothing to play; dropped before writing
+    }
+
+    int done = __atomic_add_fetch(&job->done, 1, __ATOMIC_RELAXED);
+    if (done % 64 == 0 || done == job->total)
+        fprintf(stderr, "\r  searched %d / %d", done, job->total);
+}
+
+int main(int argc, char *argv[]) {
+    int plies = DEFAULT_PLIES;
+    int iterations = DEFAULT_ITERATIONS;
+    const char *out_path = "book.bin";
+    MCTSConfig config;
+    mcts_config_default(&config);
+    config.threads = 0;     // All cores unless told otherwise
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--plies") == 0 && i + 1 < argc) plies = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) iterations = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) config.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) config.seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--plies N] [--iterations N] [--threads N] [--seed S] [--out FILE]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (plies < 1 || iterations < 1) {
+        fprintf(stderr, "plies and iterations must be positive\n");
+        return 1;
+    }
+    mcts_config_clamp(&config);
+    double start = omp_get_wtime();
+
+    // Every distinct position with fewer than plies moves played
+    PositionList all = {NULL, 0, 0}, level = {NULL, 0, 0}, next = {NULL, 0, 0};
+    int *depths = NULL;
+    GameState initial, canonical;
+    init_board(&initial);
+    book_canonical(&initial, &canonical);
+    int ok = push_position(&level, &canonical);
+    for (int ply = 0; ok && ply < plies; ply++) {
+        printf("ply %2d: %zu positions\n", ply, level.count);
+        int *grown = realloc(depths, (all.count + level.count) * sizeof(int));
+        ok = grown != NULL;
+        if (!ok) break;
+        depths = grown;
+        for (size_t i = 0; ok && i < level.count; i++) {
+            depths[all.count] = ply;
+            ok = push_position(&all, &level.states[i]);
+        }
+        if (ok && ply + 1 < plies) {
+            ok = next_ply(&level, &next);
+            PositionList swap = level;
+            level = next;
+            next = swap;
+        }
+    }
+    fflush(stdout);
+    BookEntry *entries = ok ? malloc(all.count * sizeof(BookEntry)) : NULL;
+    if (entries == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // Each pool worker searches whole positions on its own sequential engine
+    TaskPool tasks;
+    task_pool_init(&tasks, config.threads);
+    int workers = task_pool_size(&tasks);
+    MCTSEngine *engines = malloc(workers * sizeof(MCTSEngine));
+    config.mode = MCTS_SEQUENTIAL;
+    ok = engines != NULL;
+    for (int w = 0; ok && w < workers; w++) {
+        MCTSConfig engine_config = config;
+        engine_config.seed = config.seed + w;
+        ok = mcts_engine_init(&engines[w], &engine_config, &tasks);
+    }
+    if (!ok) {
+        fprintf(stderr, "cannot initialise engines\n");
+        return 1;
+    }
+
+    BuildJob job = {engines, all.states, depths, entries, search_iterations(iterations), 0, (int)all.count};
+    task_pool_run(&tasks, build_task, &job, (int)all.count);
+    fprintf(stderr, "\n");
+
+    // Keep the positions that have a move
+    size_t count = 0;
+    for (size_t i = 0; i < all.count; i++)
+        if (entries[i].visits > 0) entries[count++] = entries[i];
+
+    if (!book_write(out_path, entries, count, plies, iterations)) {
+        fprintf(stderr, "cannot write %s\n", out_path);
+        return 1;
+    }
+    double elapsed = omp_get_wtime() - start;
+    printf("wrote %zu entries (%zu bytes) to %s in %.1f s with %d threads\n", count,
+           sizeof(BookHeader) + count * sizeof(BookEntry), out_path, elapsed, workers);
+
+    for (int w = 0; w < workers; w++) mcts_engine_destroy(&engines[w]);
+    task_pool_destroy(&tasks);
+    free(engines);
+    free(entries);
+    free(depths);
+    free(all.states);
+    free(level.states);
+    free(next.states);
+    return 0;
+}
\ No newline at end of file
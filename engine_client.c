@@ -0,0 +1,84 @@
+#define _POSIX_C_SOURCE 200809L   // fdopen, dup
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <omp.h>
+
+// Drives an engine_server over its Unix socket: sends each command (from
+// the command line, or one per stdin line), waits for its reply and prints
+// it with the round-trip time seen by the client.
+//
+//   mcts_client /tmp/mcts.sock "position startpos" "go time 100" stats
+
+#define LINE_MAX_LEN 1024
+
+typedef struct {
+    FILE *in;
+    FILE *out;
+    long requests;
+    double rtt_total;
+    double rtt_max;
+} Client;
+
+// Send one command and print its reply. Returns 0 once the connection is gone.
+static int request(Client *client, const char *command) {
+    char line[LINE_MAX_LEN];
+    double start = omp_get_wtime();
+    fprintf(client->out, "%s\n", command);
+    fflush(client->out);
+    if (fgets(line, sizeof(line), client->in) == NULL) return 0;
+    double rtt = omp_get_wtime() - start;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    printf("%s rtt_ms=%.3f\n", line, rtt * 1000.0);
+    client->requests++;
+    client->rtt_total += rtt;
+    if (rtt > client->rtt_max) client->rtt_max = rtt;
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s SOCKET [command ...]\n", argv[0]);
+        return 1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (fd < 0 || strlen(argv[1]) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "bad socket path %s\n", argv[1]);
+        return 1;
+    }
+    strcpy(addr.sun_path, argv[1]);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "cannot connect to %s\n", argv[1]);
+        close(fd);
+        return 1;
+    }
+
+    Client client = {fdopen(fd, "r"), fdopen(dup(fd), "w"), 0, 0.0, 0.0};
+    int connected = 1;
+    if (argc > 2) {
+        for (int i = 2; i < argc && connected; i++)
+            connected = request(&client, argv[i]);
+    } else {
+        char line[LINE_MAX_LEN];
+        while (connected && fgets(line, sizeof(line), stdin) != NULL) {
+            line[strcspn(line, "\r\n")] = '\0';
+            if (line[0] != '\0') connected = request(&client, line);
+        }
+    }
+
+    if (client.requests > 0)
+        fprintf(stderr, "%ld requests, mean rtt %.3f ms, max %.3f ms\n", client.requests,
+                client.rtt_total / client.requests * 1000.0, client.rtt_max * 1000.0);
+    fclose(client.in);
+    fclose(client.out);
+    return connected ? 0 : 1;
+}
\ No newline at end of file
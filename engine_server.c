@@ -0,0 +1,393 @@
+#define _POSIX_C_SOURCE 200809L   // fdopen, dup
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "mcts_engine.h"
+
+// Long-running engine speaking one command per line over stdin/stdout or
+// a Unix socket. Every command gets exactly one reply line ending in the
+// time the server spent on it:
+//
+//   position startpos | position <64 x X/O/.> <X|O>  -> ok position
+//   play <square>|pass                               -> ok play
+//   go [iterations N] [time MS] [early]              -> bestmove <square> ...
+//   stop                                             -> ok stop (after go's bestmove)
+//   set <name> <value>                               -> ok set
+//   stats                                            -> ok stats ...
+//   save <file>                                      -> ok save (tree checkpoint)
+//   load <file>                                      -> ok load (position = saved root)
+//   newgame                                          -> ok newgame
+//   quit                                             -> ok quit
+//
+// go searches on its own thread, so stop and stats are answered while it
+// runs; any other command waits for it to finish. The tree, table and
+// worker pool stay warm across requests and across socket connections.
+// With --book FILE, booked positions are answered from the mapped opening
+// book without searching.
+
+#define LINE_MAX_LEN 1024
+#define DEFAULT_GO_ITERATIONS 10000
+
+static const char *mode_names[NUM_MODES] = {"sequential", "leaf", "root", "virtual_loss", "sync"};
+
+typedef struct {
+    MCTSEngine engine;
+    GameState state;
+    FILE *out;
+    pthread_mutex_t out_lock;
+
+    pthread_t search_thread;
+    int searching;          // A go thread exists and has not been joined
+    int search_done;        // Set by that thread just before it replies
+    int cancel;
+    SearchLimits limits;
+    GameState search_state;
+    double go_start;
+    MCTSEngineStats stats;  // Snapshot taken while no search is running
+
+    long requests;
+    double latency_total;
+    double latency_max;
+} Server;
+
+// SQUARES
+
+static int parse_square(const char *text) {
+    if (strlen(text) != 2) return -1;
+    int c = text[0] - 'a', r = text[1] - '1';
+    if (c < 0 || c >= SIZE || r < 0 || r >= SIZE) return -1;
+    return SQUARE(r, c);
+}
+
+static void format_square(int sq, char *text) {
+    if (sq < 0) {
+        strcpy(text, "pass");
+        return;
+    }
+    text[0] = (char)('a' + sq % SIZE);
+    text[1] = (char)('1' + sq / SIZE);
+    text[2] = '\0';
+}
+
+// REPLIES
+
+// Write one reply line with the request's latency appended
+static void reply(Server *server, double start, const char *fmt, ...) {
+    pthread_mutex_lock(&server->out_lock);
+    double elapsed = omp_get_wtime() - start;
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(server->out, fmt, args);
+    va_end(args);
+    fprintf(server->out, " time_ms=%.3f\n", elapsed * 1000.0);
+    fflush(server->out);
+
+    server->requests++;
+    server->latency_total += elapsed;
+    if (elapsed > server->latency_max) server->latency_max = elapsed;
+    pthread_mutex_unlock(&server->out_lock);
+}
+
+// SEARCH
+
+static void* search_thread(void *arg) {
+    Server *server = arg;
+    MCTSResult result;
+    int found = mcts_engine_search(&server->engine, &server->search_state, &server->limits, &result);
+
+    // No move either because the side to move must pass or because the
+    // search was stopped before its first playout
+    char move[8];
+    if (found) format_square(result.move, move);
+    else strcpy(move, has_valid_moves(&server->search_state) ? "none" : "pass");
+    __atomic_store_n(&server->search_done, 1, __ATOMIC_RELEASE);
+    reply(server, server->go_start,
+          "bestmove %s visits=%d winrate=%.4f proven=%d playouts=%d reused=%d book=%d", move,
+          result.visits, result.win_rate, result.proven, result.timing.iterations, result.reused,
+          result.from_book);
+    return NULL;
+}
+
+// Wait for a running go to finish (cancel it first if stop is set)
+static void finish_search(Server *server, int stop) {
+    if (!server->searching) return;
+    if (stop) __atomic_store_n(&server->cancel, 1, __ATOMIC_RELAXED);
+    pthread_join(server->search_thread, NULL);
+    server->searching = 0;
+}
+
+static void cmd_go(Server *server, double start, char *args) {
+    SearchLimits limits = {0, 0.0, 0, &server->cancel};
+    for (char *tok = strtok(args, " "); tok != NULL; tok = strtok(NULL, " ")) {
+        if (strcmp(tok, "iterations") == 0 && (tok = strtok(NULL, " ")) != NULL) {
+            limits.iterations = atoi(tok);
+        } else if (strcmp(tok, "time") == 0 && (tok = strtok(NULL, " ")) != NULL) {
+            limits.seconds = atof(tok) / 1000.0;
+        } else if (strcmp(tok, "early") == 0) {
+            limits.early_stop = 1;
+        } else {
+            reply(server, start, "error go: bad argument");
+            return;
+        }
+    }
+    if (limits.iterations <= 0 && limits.seconds <= 0.0) limits.iterations = DEFAULT_GO_ITERATIONS;
+
+    mcts_engine_get_stats(&server->engine, &server->stats);
+    server->limits = limits;
+    server->search_state = server->state;
+    server->go_start = start;
+    __atomic_store_n(&server->cancel, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&server->search_done, 0, __ATOMIC_RELAXED);
+    if (pthread_create(&server->search_thread, NULL, search_thread, server) != 0) {
+        reply(server, start, "error go: cannot start search");
+        return;
+    }
+    server->searching = 1;
+}
+
+// COMMANDS
+
+static int cmd_position(Server *server, char *args) {
+    char board[LINE_MAX_LEN], side[8];
+    if (strncmp(args, "startpos", 8) == 0) {
+        init_board(&server->state);
+        return 1;
+    }
+    if (sscanf(args, "%1023s %7s", board, side) != 2 || strlen(board) != SIZE * SIZE) return 0;
+
+    GameState state = {0, 0, 0, side[0] == 'O' ? WHITE : BLACK};
+    for (int sq = 0; sq < SIZE * SIZE; sq++) {
+        if (board[sq] == 'X') state.black |= SQUARE_BIT(sq);
+        else if (board[sq] == 'O') state.white |= SQUARE_BIT(sq);
+        else if (board[sq] != '.') return 0;
+    }
+    state.hash = compute_hash(&state);
+    server->state = state;
+    return 1;
+}
+
+static int cmd_play(Server *server, char *args) {
+    char move[8];
+    if (sscanf(args, "%7s", move) != 1) return 0;
+    if (strcmp(move, "pass") == 0) {
+        if (has_valid_moves(&server->state)) return 0;
+        pass_turn(&server->state);
+        return 1;
+    }
+    int sq = parse_square(move);
+    if (sq < 0 || !is_valid_move(&server->state, sq / SIZE, sq % SIZE)) return 0;
+    make_move_square(&server->state, sq);
+    return 1;
+}
+
+// Restore a saved tree and continue from its root position
+static int cmd_load(Server *server, char *args) {
+    char path[LINE_MAX_LEN];
+    if (sscanf(args, "%1023s", path) != 1 || !mcts_engine_load(&server->engine, path)) return 0;
+    server->state = node_state(server->engine.tree.root);
+    return 1;
+}
+
+static int cmd_set(Server *server, char *args) {
+    char name[64], value[64];
+    if (sscanf(args, "%63s %63s", name, value) != 2) return 0;
+    MCTSConfig *config = &server->engine.config;
+    if (strcmp(name, "mode") == 0) {
+        for (int m = 0; m < NUM_MODES; m++)
+            if (strcmp(value, mode_names[m]) == 0) {
+                config->mode = m;
+                return 1;
+            }
+        return 0;
+    }
+    if (strcmp(name, "ucb_constant") == 0) config->ucb_constant = atof(value);
+    else if (strcmp(name, "rollouts") == 0) config->rollouts = atoi(value);
+    else if (strcmp(name, "virtual_loss") == 0) config->virtual_loss = atoi(value);
+    else if (strcmp(name, "max_path_len") == 0) config->max_path_len = atoi(value);
+    else if (strcmp(name, "endgame_empties") == 0) config->endgame_empties = atoi(value);
+    else if (strcmp(name, "root_merge_depth") == 0) config->root_merge_depth = atoi(value);
+    else if (strcmp(name, "root_sync_interval") == 0) config->root_sync_interval = atoi(value);
+    else if (strcmp(name, "root_sync_depth") == 0) config->root_sync_depth = atoi(value);
+    else if (strcmp(name, "probe_interval") == 0) config->probe_interval = atoi(value);
+    else return 0;
+    mcts_config_clamp(config);
+    return 1;
+}
+
+static void cmd_stats(Server *server, double start) {
+    // A running search owns the engine; report the snapshot from before it
+    if (server->searching && __atomic_load_n(&server->search_done, __ATOMIC_ACQUIRE))
+        finish_search(server, 0);
+    if (!server->searching) mcts_engine_get_stats(&server->engine, &server->stats);
+    MCTSEngineStats stats = server->stats;
+    pthread_mutex_lock(&server->out_lock);
+    long requests = server->requests;
+    double mean = requests > 0 ? server->latency_total / requests : 0.0;
+    double max = server->latency_max;
+    pthread_mutex_unlock(&server->out_lock);
+    reply(server, start,
+          "ok stats searches=%ld playouts=%ld book_hits=%ld search_s=%.3f tree_bytes=%zu mode=%s "
+          "requests=%ld mean_ms=%.3f max_ms=%.3f searching=%d",
+          stats.searches, stats.playouts, stats.book_hits, stats.search_time, stats.tree_bytes,
+          mode_names[server->engine.config.mode], requests, mean * 1000.0, max * 1000.0,
+          server->searching);
+}
+
+// Handle one line. Returns 0 when the client asked to quit.
+static int handle_line(Server *server, char *line) {
+    double start = omp_get_wtime();
+    line[strcspn(line, "\r\n")] = '\0';
+    char *cmd = strtok(line, " ");
+    if (cmd == NULL) return 1;
+    char none[1] = "";
+    char *args = strtok(NULL, "");
+    if (args == NULL) args = none;
+
+    if (strcmp(cmd, "stop") == 0) {
+        finish_search(server, 1);
+        reply(server, start, "ok stop");
+        return 1;
+    }
+    if (strcmp(cmd, "stats") == 0) {
+        cmd_stats(server, start);
+        return 1;
+    }
+    if (strcmp(cmd, "quit") == 0) {
+        finish_search(server, 1);
+        reply(server, start, "ok quit");
+        return 0;
+    }
+
+    // Everything else needs the engine to itself, so it waits for a
+    // running go to end by its own limits
+    finish_search(server, 0);
+    if (strcmp(cmd, "go") == 0) {
+        cmd_go(server, start, args);
+    } else if (strcmp(cmd, "position") == 0) {
+        if (cmd_position(server, args)) reply(server, start, "ok position");
+        else reply(server, start, "error position: expected startpos or 64 squares of X/O/. and a side");
+    } else if (strcmp(cmd, "play") == 0) {
+        if (cmd_play(server, args)) reply(server, start, "ok play");
+        else reply(server, start, "error play: illegal move");
+    } else if (strcmp(cmd, "set") == 0) {
+        if (cmd_set(server, args)) reply(server, start, "ok set");
+        else reply(server, start, "error set: unknown setting or value");
+    } else if (strcmp(cmd, "save") == 0) {
+        char path[LINE_MAX_LEN];
+        if (sscanf(args, "%1023s", path) == 1 && mcts_engine_save(&server->engine, path))
+            reply(server, start, "ok save");
+        else reply(server, start, "error save: cannot write checkpoint");
+    } else if (strcmp(cmd, "load") == 0) {
+        if (cmd_load(server, args)) reply(server, start, "ok load");
+        else reply(server, start, "error load: not a valid checkpoint");
+    } else if (strcmp(cmd, "newgame") == 0) {
+        init_board(&server->state);
+        mcts_engine_new_game(&server->engine, &server->state);
+        reply(server, start, "ok newgame");
+    } else {
+        reply(server, start, "error unknown command: %s", cmd);
+    }
+    return 1;
+}
+
+// Serve one connection (or stdin) until end of input or quit. A search
+// still running at end of input is cancelled.
+static int serve(Server *server, FILE *in, FILE *out) {
+    char line[LINE_MAX_LEN];
+    int running = 1;
+    pthread_mutex_lock(&server->out_lock);
+    server->out = out;
+    pthread_mutex_unlock(&server->out_lock);
+
+    while (running && fgets(line, sizeof(line), in) != NULL)
+        running = handle_line(server, line);
+    finish_search(server, 1);
+    return running;
+}
+
+static int serve_socket(Server *server, const char *path) {
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (listener < 0 || strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "cannot create socket %s\n", path);
+        return 1;
+    }
+    strcpy(addr.sun_path, path);
+    unlink(path);
+    if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, 4) != 0) {
+        fprintf(stderr, "cannot listen on %s\n", path);
+        close(listener);
+        return 1;
+    }
+
+    // One client at a time; the engine stays warm between them
+    int running = 1;
+    while (running) {
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0) continue;
+        FILE *in = fdopen(fd, "r");
+        FILE *out = fdopen(dup(fd), "w");
+        if (in != NULL && out != NULL) running = serve(server, in, out);
+        if (in != NULL) fclose(in);
+        if (out != NULL) fclose(out);
+    }
+
+    close(listener);
+    unlink(path);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *socket_path = NULL;
+    const char *book_path = NULL;
+    MCTSConfig config;
+    mcts_config_default(&config);
+    config.mode = MCTS_ROOT_PARALLEL_VIRTUAL_LOSS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) socket_path = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) config.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) config.seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--book") == 0 && i + 1 < argc) book_path = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--socket PATH] [--threads N] [--seed S] [--book FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    static Server server;
+    if (!mcts_engine_init(&server.engine, &config, NULL)) {
+        fprintf(stderr, "cannot initialise engine\n");
+        return 1;
+    }
+    // The book is mapped shared, so servers started with the same file
+    // keep one copy of it in memory
+    static Book book;
+    if (book_path != NULL) {
+        if (!book_open(&book, book_path)) {
+            fprintf(stderr, "cannot open book %s\n", book_path);
+            mcts_engine_destroy(&server.engine);
+            return 1;
+        }
+        mcts_engine_set_book(&server.engine, &book);
+    }
+    pthread_mutex_init(&server.out_lock, NULL);
+    init_board(&server.state);
+
+    int status = socket_path != NULL ? serve_socket(&server, socket_path)
+                                     : (serve(&server, stdin, stdout), 0);
+
+    pthread_mutex_destroy(&server.out_lock);
+    mcts_engine_destroy(&server.engine);
+    book_close(&book);
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include "othello.h"
+
+#define ENDGAME_SCORE_MAX 64
+
+int count_empties(const GameState *state);
+int solve_endgame(const GameState *state, int alpha, int beta);
+int solve_endgame_wld(const GameState *state);
+int solve_endgame_best(const GameState *state, int *best_sq);
+
+#endif
\ No newline at end of file
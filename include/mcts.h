@@ -7,25 +7,33 @@
 #include <time.h>
 
 #include "othello.h"
+#include "rng.h"
 #include "mcts_util.h"
+#include "mcts_config.h"
+#include "mcts_tree.h"
+#include "mcts_tt.h"
+#include "mcts_ucb.h"
+#include "mcts_budget.h"
+#include "mcts_probe.h"
 #include "mcts_leaf.h"
 #include "mcts_root.h"
-
-#define VIRTUAL_LOSS 1.0    // Virtual loss amount
-#define MAX_PATH_LEN 1024   // Maximum path length for a single simulation
-#define UCB_CONSTANT 1.414
-#define ROLLOUTS 20
+#include "mcts_batch.h"
+#include "endgame.h"
 
 typedef struct {
     Node *root;
     int iterations;
 } ThreadData;
 
-double ucb1(Node *node);
-Node* select_child(Node *node);
-void expand(Node *node);
-double simulate(GameState *state, int original_player, unsigned int *seed, int include_seed);
-void backpropagate(Node *node, double result);
-MCTSTiming mcts_sequential(Node *root, int iterations);
+Node* select_child(Node *node, TranspositionTable *tt, const MCTSConfig *config);
+void expand(Node *node, NodeArena *arena);
+double simulate(GameState *state, int original_player, RNG *rng);
+void backpropagate(Node *node, double result, TranspositionTable *tt);
+void backpropagate_batch(Node *node, int count, double wins);
+int settle_proof(Node *node);
+int solve_leaf(Node *node, const MCTSConfig *config, double *result);
+double evaluate_leaf(Node *node, const MCTSConfig *config, RNG *rng);
+MCTSTiming mcts_sequential(Node *root, NodePool *pool, TranspositionTable *tt, const MCTSConfig *config,
+                           const SearchLimits *limits, RNG *rng);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef MCTS_ARENA_H
+#define MCTS_ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_BLOCK_SIZE (1 << 20)  // Bytes per arena block
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+    _Alignas(16) unsigned char data[];
+} ArenaBlock;
+
+// Bump allocator owned by a single thread. Nothing is freed individually;
+// arena_reset rewinds the whole arena and keeps its blocks for reuse.
+typedef struct {
+    _Alignas(64) ArenaBlock *first;
+    ArenaBlock *current;
+} NodeArena;
+
+// One arena per worker thread, so parallel expansion never contends
+typedef struct {
+    NodeArena *arenas;
+    int num_arenas;
+} NodePool;
+
+void arena_init(NodeArena *arena);
+void* arena_alloc(NodeArena *arena, size_t size);
+void arena_reset(NodeArena *arena);
+void arena_destroy(NodeArena *arena);
+size_t arena_bytes_used(const NodeArena *arena);
+
+int node_pool_init(NodePool *pool, int num_arenas);
+int node_pool_reserve(NodePool *pool, int num_arenas);
+NodeArena* node_pool_arena(NodePool *pool);
+NodeArena* node_pool_arena_at(NodePool *pool, int worker);
+void node_pool_reset(NodePool *pool);
+void node_pool_destroy(NodePool *pool);
+size_t node_pool_bytes_used(const NodePool *pool);
+
+#endif
\ No newline at end of file
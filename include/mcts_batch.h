@@ -0,0 +1,10 @@
+#ifndef MCTS_BATCH_H
+#define MCTS_BATCH_H
+
+#include "othello.h"
+#include "rng.h"
+
+int simulate_batch_lanes(void);
+void simulate_batch(const GameState *states, int count, double *results, RNG *rng);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef MCTS_BOOK_H
+#define MCTS_BOOK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "othello.h"
+
+#define BOOK_MAGIC "MCTSBOOK"
+#define BOOK_VERSION 1
+#define BOOK_SYMMETRIES 8
+
+// One booked position. key is the Zobrist hash of the position's canonical
+// form (see book_canonical) and move is the reply in that same frame.
+typedef struct {
+    uint64_t key;
+    uint32_t visits;     // Visits of the booked move in the building search
+    uint16_t value;      // Its win rate for the side to move, scaled to 0..65535
+    uint8_t move;
+    uint8_t ply;         // Depth at which the position was booked
+} BookEntry;
+
+// File layout: this header followed by count entries sorted by key
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_size;
+    uint64_t count;
+    uint32_t plies;      // Build settings, for reference
+    uint32_t iterations;
+} BookHeader;
+
+// A book file mapped read-only, so every process using it shares its pages
+typedef struct {
+    const BookHeader *header;
+    const BookEntry *entries;
+    size_t count;
+    void *map;
+    size_t map_size;
+} Book;
+
+int book_canonical(const GameState *state, GameState *canonical);
+int book_transform_square(int sq, int sym);
+int book_untransform_square(int sq, int sym);
+int book_write(const char *path, BookEntry *entries, size_t count, int plies, int iterations);
+int book_open(Book *book, const char *path);
+void book_close(Book *book);
+int book_lookup(const Book *book, const GameState *state, BookEntry *entry);
+
+#endif
\ No newline at end of file
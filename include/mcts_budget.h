@@ -0,0 +1,36 @@
+#ifndef MCTS_BUDGET_H
+#define MCTS_BUDGET_H
+
+#include "mcts_util.h"
+
+#define EARLY_STOP_INTERVAL 64   // Playouts between checks of the root decision
+
+// How long one search may run. Any limit left at 0 is off. A search with
+// no cap, no deadline and no cancel flag returns at once; one with only a
+// cancel flag runs until it is raised.
+typedef struct {
+    int iterations;     // Playout cap
+    double seconds;     // Wall-clock budget
+    int early_stop;     // Stop once the most-visited root child cannot be caught
+    const int *cancel;  // Raised by another thread to stop the search, or NULL
+} SearchLimits;
+
+// Running state of those limits, shared by every thread of one search
+typedef struct {
+    SearchLimits limits;
+    double start;
+    double deadline;    // omp_get_wtime() value to stop at, INFINITY for none
+    int next_check;     // Playout count at which to test the root decision again
+    int stopped;        // Set by whichever thread first finds the budget spent
+} SearchBudget;
+
+static inline SearchLimits search_iterations(int iterations) {
+    return (SearchLimits){iterations, 0.0, 0, NULL};
+}
+
+void budget_start(SearchBudget *budget, const SearchLimits *limits);
+int budget_expired(SearchBudget *budget);
+int budget_done(SearchBudget *budget, const Node *root, int done);
+int root_decision_settled(const Node *root, double remaining);
+
+#endif
\ No newline at end of file
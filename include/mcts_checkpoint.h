@@ -0,0 +1,36 @@
+#ifndef MCTS_CHECKPOINT_H
+#define MCTS_CHECKPOINT_H
+
+#include <stdint.h>
+
+#include "mcts_tree.h"
+
+#define CHECKPOINT_MAGIC "MCTSTREE"
+#define CHECKPOINT_VERSION 1
+
+// On-disk search tree. The header is followed by one array per field, each
+// holding node_count values in breadth-first order, so a node's children
+// are the consecutive run starting at its first_child:
+//
+//   uint64_t stats[n]         packed visits and wins, as in Node
+//   uint32_t first_child[n]
+//   uint8_t  num_children[n]
+//   int8_t   move[n]          square played to reach the node, -1 at the root
+//   uint8_t  proven[n]
+//   uint8_t  expanded[n]
+//
+// Boards are not stored; loading replays each move from its parent.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t node_count;
+    uint64_t root_black;
+    uint64_t root_white;
+    uint32_t root_player;      // Side to move at the root
+    uint32_t reserved;
+} CheckpointHeader;
+
+int tree_save(const MCTSTree *tree, const char *path);
+int tree_load(MCTSTree *tree, const char *path);
+
+#endif
\ No newline at end of file
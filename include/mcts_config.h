@@ -0,0 +1,39 @@
+#ifndef MCTS_CONFIG_H
+#define MCTS_CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Defaults for the runtime settings below
+#define VIRTUAL_LOSS 1      // Visits, scored as losses, held by each in-flight simulation
+#define MAX_PATH_LEN 1024   // Maximum path length for a single simulation (hard limit)
+#define UCB_CONSTANT 1.414
+#define ROLLOUTS 20         // Default leaf-parallel batch size
+#define ROOT_MERGE_DEPTH 4 // Tree levels root-parallel search merges back into the shared tree
+#define ROOT_SYNC_INTERVAL 32 // Iterations between statistic syncs in synchronized root-parallel search
+#define ROOT_SYNC_DEPTH 1  // Tree levels below the root shared by those syncs (1 or 2)
+#define ENDGAME_EMPTIES 10 // Solve exactly instead of rolling out at or below this
+#define PROBE_INTERVAL 16  // Time the phases of one iteration in this many
+
+// Search parameters. Every search function reads them from here, so
+// engines with different settings can share a process.
+typedef struct {
+    int threads;              // Pool workers; 0 for omp_get_max_threads()
+    double ucb_constant;
+    int rollouts;             // Leaf-parallel batch size
+    int virtual_loss;
+    int max_path_len;         // At most MAX_PATH_LEN
+    int endgame_empties;
+    int root_merge_depth;
+    int root_sync_interval;
+    int root_sync_depth;      // 1 or 2
+    int probe_interval;       // Phase timing sample rate; 0 for none
+    size_t tt_bytes;          // Transposition table size; 0 for none
+    int mode;                 // MCTSMode the engine searches with
+    uint64_t seed;
+} MCTSConfig;
+
+void mcts_config_default(MCTSConfig *config);
+void mcts_config_clamp(MCTSConfig *config);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef MCTS_ENGINE_H
+#define MCTS_ENGINE_H
+
+#include "mcts.h"
+#include "mcts_ponder.h"
+#include "mcts_book.h"
+#include "mcts_checkpoint.h"
+
+typedef enum {
+    MCTS_SEQUENTIAL,
+    MCTS_LEAF_PARALLEL,
+    MCTS_ROOT_PARALLEL,
+    MCTS_ROOT_PARALLEL_VIRTUAL_LOSS,
+    MCTS_ROOT_PARALLEL_SYNC
+} MCTSMode;
+
+#define NUM_MODES 5
+
+// Outcome of one search
+typedef struct {
+    int move;            // Square to play, -1 when the side to move has none
+    int visits;          // Visits of the chosen child
+    double win_rate;     // Its win rate for the side to move
+    int proven;          // Its PROVEN_* status
+    int reused;          // Root visits carried over from earlier searches
+    int from_book;       // Taken from the opening book without searching
+    MCTSTiming timing;
+} MCTSResult;
+
+// Totals over an engine's lifetime
+typedef struct {
+    long searches;
+    long playouts;
+    long book_hits;
+    double search_time;
+    size_t tree_bytes;   // Node memory currently in use
+} MCTSEngineStats;
+
+// A complete search engine: settings, a persistent tree, a transposition
+// table, a worker pool and optional pondering. Engines are independent, so
+// several with different settings can run in one process. config may be
+// edited between searches, except for threads and tt_bytes.
+typedef struct {
+    MCTSConfig config;
+    MCTSTree tree;
+    TranspositionTable tt;
+    TaskPool *tasks;
+    TaskPool own_tasks;  // Used unless the engine was given a shared pool
+    RNG rng;
+    Ponderer ponder;
+    const Book *book;    // Consulted before searching; NULL for none
+    MCTSEngineStats stats;
+} MCTSEngine;
+
+int mcts_engine_init(MCTSEngine *engine, const MCTSConfig *config, TaskPool *tasks);
+void mcts_engine_destroy(MCTSEngine *engine);
+void mcts_engine_new_game(MCTSEngine *engine, const GameState *state);
+int mcts_engine_search(MCTSEngine *engine, const GameState *state, const SearchLimits *limits,
+                       MCTSResult *result);
+int mcts_engine_save(MCTSEngine *engine, const char *path);
+int mcts_engine_load(MCTSEngine *engine, const char *path);
+void mcts_engine_set_book(MCTSEngine *engine, const Book *book);
+int mcts_engine_ponder(MCTSEngine *engine, const GameState *state, const SearchLimits *limits);
+int mcts_engine_stop(MCTSEngine *engine);
+void mcts_engine_get_stats(const MCTSEngine *engine, MCTSEngineStats *stats);
+
+#endif
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define MCTS_LEAF_H
 
 #include "mcts_util.h"
+#include "task_pool.h"
 #include "mcts.h"
 
-MCTSTiming mcts_leaf_parallel(Node *root, int iterations);
+MCTSTiming mcts_leaf_parallel(Node *root, NodePool *pool, TaskPool *tasks, const MCTSConfig *config,
+                              const SearchLimits *limits, RNG *rng);
 
 #endif
\ No newline at end of file
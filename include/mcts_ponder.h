@@ -0,0 +1,30 @@
+#ifndef MCTS_PONDER_H
+#define MCTS_PONDER_H
+
+#include <pthread.h>
+
+#include "mcts.h"
+
+// Background search on the opponent's time. While a ponder is running it
+// owns the tree and transposition table: the caller must not touch either
+// until ponder_stop or ponder_finish returns.
+typedef struct {
+    MCTSTree *tree;
+    TaskPool *tasks;
+    TranspositionTable *tt;
+    const MCTSConfig *config;
+    SearchLimits limits;
+    RNG rng;
+    pthread_t thread;
+    int cancel;          // Raised to end the running search
+    int active;
+    MCTSTiming timing;   // Result of the last ponder
+} Ponderer;
+
+void ponder_init(Ponderer *ponder, MCTSTree *tree, TaskPool *tasks, TranspositionTable *tt,
+                 const MCTSConfig *config, uint64_t seed);
+int ponder_start(Ponderer *ponder, const GameState *state, const SearchLimits *limits);
+int ponder_stop(Ponderer *ponder);
+int ponder_finish(Ponderer *ponder, const GameState *state);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef MCTS_PROBE_H
+#define MCTS_PROBE_H
+
+#include <stdint.h>
+#include <omp.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "mcts_util.h"
+
+// Sampled phase timing. Every search loop is written once as an always-
+// inline function taking a constant instrumented flag and is expanded
+// twice: the instrumented copy reads the cycle counter around the phases
+// of one iteration in config->probe_interval, the plain copy has no probe
+// code at all. Sampled cycles are scaled up to the whole run and converted
+// to seconds against the wall clock. Building with MCTS_NO_PROBES leaves
+// only the plain copies, and searches report total time and iterations.
+
+#ifdef MCTS_NO_PROBES
+#define PROBES_ENABLED 0
+#else
+#define PROBES_ENABLED 1
+#endif
+
+#define PHASE_SELECTION 0
+#define PHASE_EXPANSION 1
+#define PHASE_SIMULATION 2
+#define PHASE_BACKPROPAGATION 3
+#define NUM_PHASES 4
+
+#define PROBE_INLINE static inline __attribute__((always_inline))
+
+// Whether a loop copy times iteration i
+#define PROBE_SAMPLE(instrumented, interval, i) ((instrumented) && (i) % (interval) == 0)
+
+// Run the instrumented copy of a loop when config samples phases
+#if PROBES_ENABLED
+#define PROBE_DISPATCH(config, instrumented_call, plain_call) \
+    ((config)->probe_interval > 0 ? (instrumented_call) : (plain_call))
+#else
+#define PROBE_DISPATCH(config, instrumented_call, plain_call) (plain_call)
+#endif
+
+// One thread's sampled phase cycles
+typedef struct {
+    uint64_t ticks[NUM_PHASES];
+    int samples;            // Iterations timed
+    uint64_t start_ticks;   // Counter and wall clock when the loop began,
+    double start_time;      // for converting cycles to seconds
+} PhaseProbe;
+
+static inline uint64_t probe_ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)(omp_get_wtime() * 1e9);
+#endif
+}
+
+// Charge the cycles since *mark to phase and restart the mark there
+static inline void probe_lap(PhaseProbe *probe, int phase, uint64_t *mark) {
+    uint64_t now = probe_ticks();
+    probe->ticks[phase] += now - *mark;
+    *mark = now;
+}
+
+void probe_start(PhaseProbe *probe);
+void probe_finish(const PhaseProbe *probe, int iterations, MCTSTiming *timing);
+
+#endif
\ No newline at end of file
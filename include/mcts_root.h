@@ -2,9 +2,14 @@
 #define MCTS_ROOT_H
 
 #include "mcts_util.h"
+#include "task_pool.h"
 #include "mcts.h"
 
-MCTSTiming mcts_root_parallel(Node *root, int total_iterations);
-MCTSTiming mcts_root_parallel_virtual_loss(Node *root, int total_iterations);
+MCTSTiming mcts_root_parallel(Node *root, NodePool *pool, TaskPool *tasks, const MCTSConfig *config,
+                              const SearchLimits *limits, RNG *rng);
+MCTSTiming mcts_root_parallel_sync(Node *root, NodePool *pool, TaskPool *tasks, const MCTSConfig *config,
+                                   const SearchLimits *limits, RNG *rng);
+MCTSTiming mcts_root_parallel_virtual_loss(Node *root, NodePool *pool, TaskPool *tasks, TranspositionTable *tt,
+                                           const MCTSConfig *config, const SearchLimits *limits, RNG *rng);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef MCTS_SELFPLAY_H
+#define MCTS_SELFPLAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "mcts_engine.h"
+
+#define SELFPLAY_BUFFER_BYTES (4 << 20)   // Records a worker gathers per write
+#define SELFPLAY_POLICY_SCALE 65535       // Policy entries are visit shares of this
+
+// One searched position, 152 bytes. Files are plain arrays of records in
+// native byte order, optionally gzip-compressed as a whole.
+typedef struct {
+    uint64_t black, white;
+    uint16_t policy[SIZE * SIZE];   // Root visit share of each square
+    uint32_t root_visits;           // Visits the shares were taken from
+    uint8_t player;                 // Side to move
+    uint8_t move;                   // Square played
+    uint8_t ply;
+    int8_t outcome;                 // Final result for player: 1 win, 0 draw, -1 loss
+} SelfPlayRecord;
+
+// A chunk of encoded records on its way from a worker to the file
+typedef struct SelfPlayBuffer {
+    struct SelfPlayBuffer *next;
+    size_t used;
+    unsigned char data[];
+} SelfPlayBuffer;
+
+// Background writer. Workers fill their own buffers and hand over full
+// ones; a single thread writes them out in large sequential writes, so
+// search never waits on the disk unless every spare buffer is in flight.
+typedef struct {
+    FILE *file;
+    void *gz;                       // gzFile when compressing
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t filled;          // The writer waits here for full buffers
+    pthread_cond_t emptied;         // Workers wait here for a spare buffer
+    SelfPlayBuffer *full_head, *full_tail;
+    SelfPlayBuffer *spare;
+    SelfPlayBuffer **buffers;       // Every buffer, for freeing
+    int num_buffers;
+    int closing;
+    int error;
+    size_t bytes;                   // Uncompressed bytes written
+    int writes;
+} SelfPlayWriter;
+
+typedef struct {
+    int games;
+    SearchLimits limits;            // Per move
+    int sample_plies;               // Plies played in proportion to visits, for variety
+    int compress;                   // gzip the output (needs a build with MCTS_ZLIB)
+} SelfPlayOptions;
+
+typedef struct {
+    int games;
+    long records;
+    size_t bytes;                   // Uncompressed record bytes
+    int writes;
+    double elapsed;
+    double records_per_sec;
+    double mb_per_sec;
+} SelfPlayReport;
+
+int selfplay_compression_available(void);
+int selfplay_writer_open(SelfPlayWriter *writer, const char *path, int compress, int buffers);
+SelfPlayBuffer* selfplay_writer_submit(SelfPlayWriter *writer, SelfPlayBuffer *full);
+int selfplay_writer_close(SelfPlayWriter *writer);
+int selfplay_run(TaskPool *tasks, const MCTSConfig *config, const SelfPlayOptions *options,
+                 const char *path, SelfPlayReport *report);
+
+#endif
\ No newline at end of file
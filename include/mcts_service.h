@@ -0,0 +1,45 @@
+#ifndef MCTS_SERVICE_H
+#define MCTS_SERVICE_H
+
+#include "mcts_engine.h"
+
+// One self-play game run by the service, with its own engine and tree
+typedef struct {
+    MCTSEngine engine;
+    GameState state;
+    SearchLimits limits;        // Per move
+    double requested;           // When the pending move was asked for
+    int running;                // A worker is making this game's move
+    int finished;
+    int moves;
+    double latencies[SIZE * SIZE];  // Request to answer, one per move
+} ServiceGame;
+
+// Many independent games searched on one shared worker pool. Each worker
+// repeatedly takes the waiting game whose move is due first and makes
+// that move; a game's search may itself spread over idle workers.
+typedef struct {
+    TaskPool *tasks;
+    ServiceGame *games;
+    int num_games;
+    pthread_mutex_t lock;       // Guards each game's running, finished and requested
+} SearchService;
+
+typedef struct {
+    int games;
+    long moves;
+    double elapsed;
+    double moves_per_sec;
+    double games_per_sec;
+    double latency_p50;         // Per-move latency percentiles, seconds
+    double latency_p90;
+    double latency_p99;
+    double latency_max;
+} ServiceReport;
+
+int service_init(SearchService *service, TaskPool *tasks, int num_games,
+                 const MCTSConfig *config, const SearchLimits *limits);
+void service_destroy(SearchService *service);
+void service_play(SearchService *service, ServiceReport *report);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef MCTS_TREE_H
+#define MCTS_TREE_H
+
+#include "othello.h"
+#include "mcts_arena.h"
+#include "mcts_util.h"
+
+// A search tree that persists across moves. Nodes live in one of two
+// pools; re-rooting copies the surviving subtree into the spare pool and
+// resets the old one, so unreachable siblings are released in bulk.
+typedef struct {
+    Node *root;
+    NodePool pools[2];
+    int live;          // Index of the pool holding the current tree
+} MCTSTree;
+
+void tree_init(MCTSTree *tree, const GameState *state);
+void tree_destroy(MCTSTree *tree);
+NodePool* tree_pool(MCTSTree *tree);
+void tree_reset(MCTSTree *tree, const GameState *state);
+int tree_advance(MCTSTree *tree, int move);
+int tree_set_position(MCTSTree *tree, const GameState *state);
+size_t tree_bytes_used(const MCTSTree *tree);
+Node* tree_copy(NodeArena *arena, const Node *root, int depth);
+
+#endif
\ No newline at end of file
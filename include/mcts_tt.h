@@ -0,0 +1,29 @@
+#ifndef MCTS_TT_H
+#define MCTS_TT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TT_BUCKET_SIZE 4              // Entries per 64-byte bucket
+#define TT_DEFAULT_BYTES (4 << 20)    // Default memory budget
+
+// Statistics for one position, shared by every node that reaches it.
+// stats packs visits (high 32 bits) and wins in half points (low 32 bits)
+// so one atomic add records a whole result.
+typedef struct {
+    uint64_t key;
+    uint64_t stats;
+} TTEntry;
+
+typedef struct {
+    TTEntry *entries;
+    size_t num_buckets;   // Power of two
+} TranspositionTable;
+
+int tt_init(TranspositionTable *tt, size_t bytes);
+void tt_clear(TranspositionTable *tt);
+void tt_destroy(TranspositionTable *tt);
+int tt_lookup(const TranspositionTable *tt, uint64_t key, int *visits, double *wins);
+void tt_update(TranspositionTable *tt, uint64_t key, double result);
+
+#endif
\ No newline at end of file
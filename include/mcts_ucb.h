@@ -0,0 +1,11 @@
+#ifndef MCTS_UCB_H
+#define MCTS_UCB_H
+
+#include "mcts_util.h"
+#include "mcts_tt.h"
+
+#define UCB_TABLE_SIZE 4096   // Parent visit counts with a precomputed exploration factor
+
+int ucb_select(const Node *node, TranspositionTable *tt, double ucb_constant);
+
+#endif
\ No newline at end of file
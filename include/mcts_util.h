@@ -4,6 +4,7 @@
 #include <stdio.h>
 
 #include "othello.h"
+#include "mcts_arena.h"
 
 typedef struct {
     double selection;
@@ -11,6 +12,7 @@ typedef struct {
     double simulation;
     double backpropagation;
     double total;
+    int iterations;     // Playouts actually run
 } MCTSTiming;
 
 typedef struct {
@@ -21,18 +23,90 @@ typedef struct {
     int num_runs;
 } MCTSTimingAggregator;
 
+// Game-theoretic value of a node once the endgame solver has settled it,
+// from the point of view of player_just_moved
+#define PROVEN_NONE 0
+#define PROVEN_WIN  1
+#define PROVEN_DRAW 2
+#define PROVEN_LOSS 3
+
+// Expansion progress. A thread claims a leaf by moving it from UNEXPANDED
+// to EXPANDING with a compare-and-swap and publishes the finished children
+// array by storing EXPANDED with release ordering.
+#define NODE_UNEXPANDED 0
+#define NODE_EXPANDING  1
+#define NODE_EXPANDED   2
+
+#define NODE_VISIT (1ULL << 32)   // One visit in a packed stats word
+
+// Tree node, 56 bytes. The statistics read for every sibling during
+// selection sit at the front, and a node's children are one contiguous
+// array so scoring them walks memory linearly.
 typedef struct Node {
-    GameState state;
-    int move_row, move_col;
-    int visits;
-    double wins;  
+    uint64_t stats;                    // Visits (high 32 bits), wins in half points (low 32 bits)
+    signed char move;                  // Square played to reach this node, -1 at the root
+    unsigned char player_just_moved;   // The side to move is always its opponent
+    unsigned char num_children;
+    unsigned char proven;              // PROVEN_* result for player_just_moved
+    unsigned char expand_state;        // NODE_UNEXPANDED/EXPANDING/EXPANDED
+    struct Node *children;
     struct Node *parent;
-    struct Node **children;
-    int num_children;
-    int player_just_moved;  
-    omp_lock_t lock;  
+    uint64_t black, white;             // Board after move
+    uint64_t hash;                     // Zobrist key of that position
 } Node;
 
+// Full position stored in a node
+static inline GameState node_state(const Node *node) {
+    GameState state;
+    state.black = node->black;
+    state.white = node->white;
+    state.hash = node->hash;
+    state.player = opponent(node->player_just_moved);
+    return state;
+}
+
+// Side to move in a node's position
+static inline int node_player(const Node *node) {
+    return opponent(node->player_just_moved);
+}
+
+// Packed statistics. Every update is a single relaxed atomic add, and a
+// reader that loads the word once sees visits and wins that belong together.
+static inline uint64_t node_load_stats(const Node *node) {
+    return __atomic_load_n(&node->stats, __ATOMIC_RELAXED);
+}
+
+static inline int stats_visits(uint64_t stats) {
+    return (int)(stats >> 32);
+}
+
+static inline double stats_wins(uint64_t stats) {
+    return (uint32_t)stats * 0.5;
+}
+
+static inline int node_visits(const Node *node) {
+    return stats_visits(node_load_stats(node));
+}
+
+static inline double node_wins(const Node *node) {
+    return stats_wins(node_load_stats(node));
+}
+
+// One visit scoring result (0, 0.5 or 1)
+static inline uint64_t stats_result(double result) {
+    return NODE_VISIT | (uint64_t)(result * 2.0 + 0.5);
+}
+
+static inline void node_add_stats(Node *node, uint64_t delta) {
+    __atomic_fetch_add(&node->stats, delta, __ATOMIC_RELAXED);
+}
+
+// Proof status; relaxed atomic because parallel modes settle nodes
+// while other threads are selecting through them
+static inline int node_proven(const Node *node) {
+    return __atomic_load_n(&node->proven, __ATOMIC_RELAXED);
+}
+
 // Timing functions
 void init_timing_aggregator(MCTSTimingAggregator *agg);
 void add_timing(MCTSTimingAggregator *agg, const MCTSTiming *timing);
@@ -40,8 +114,8 @@ MCTSTiming get_average_timing(const MCTSTimingAggregator *agg);
 void print_timing(const MCTSTiming *timing, int iterations, const char *label);
 
 // Node functions
-Node* create_node(GameState *state, int r, int c, Node *parent);
-Node* clone_node(Node *original, Node *new_parent);
-void free_tree(Node *node);
+void init_node(Node *node, const GameState *state, int move, Node *parent);
+Node* create_node(NodeArena *arena, const GameState *state, int move, Node *parent);
+Node* clone_node(NodeArena *arena, Node *original, Node *new_parent);
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
@@ -13,17 +14,40 @@
 #define BLACK 1
 #define WHITE 2
 
+// Square (r, c) maps to bit r * SIZE + c of a bitboard
+#define SQUARE(r, c) ((r) * SIZE + (c))
+#define SQUARE_BIT(sq) (1ULL << (sq))
+
 typedef struct {
-    int board[SIZE][SIZE];
+    uint64_t black;
+    uint64_t white;
+    uint64_t hash;    // Zobrist key, kept up to date by make_move and pass_turn
     int player;
 } GameState;
 
+// Legal moves of one position, as a mask and as a list of squares
+typedef struct {
+    uint64_t mask;
+    int count;
+    unsigned char squares[SIZE * SIZE];
+} MoveList;
+
 void init_board(GameState *state);
 int is_valid(int r, int c);
 int opponent(int player);
+int get_cell(const GameState *state, int r, int c);
+uint64_t bitboard_moves(uint64_t own, uint64_t opp);
+uint64_t bitboard_flips(uint64_t own, uint64_t opp, int sq);
+uint64_t get_legal_moves(const GameState *state);
+uint64_t get_flips(const GameState *state, int sq);
+int generate_moves(const GameState *state, MoveList *moves);
+int generate_moves_or_pass(GameState *state, MoveList *moves);
 int is_valid_move(GameState *state, int r, int c);
 int has_valid_moves(GameState *state);
 void make_move(GameState *state, int r, int c);
+void make_move_square(GameState *state, int sq);
+void pass_turn(GameState *state);
+uint64_t compute_hash(const GameState *state);
 void get_score(GameState *state, int *black, int *white);
 int get_winner(GameState *state);
 GameState* clone_game_state(const GameState* original);
@@ -0,0 +1,53 @@
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#define TASK_DEQUE_SIZE 1024    // Tasks a worker's deque holds (power of two)
+#define TASK_SPIN_ROUNDS 4096   // Idle polls before a worker goes to sleep
+
+// A task runs fn(arg, index, worker); worker identifies the executing
+// thread (0 .. size-1) so tasks can pick per-worker arenas and buffers.
+typedef void (*TaskFn)(void *arg, int index, int worker);
+
+typedef struct Task {
+    TaskFn fn;
+    void *arg;
+    int index;
+    int *pending;           // Tasks of the same batch still running
+    int external;           // Submitted from outside the pool; signal done
+    struct Task *next;      // Link in the injection queue
+} Task;
+
+// Chase-Lev deque: the owner pushes and takes at bottom, thieves at top
+typedef struct {
+    _Alignas(64) int64_t top;
+    _Alignas(64) int64_t bottom;
+    Task *tasks[TASK_DEQUE_SIZE];
+} TaskDeque;
+
+// Persistent work-stealing pool. Workers are started once, spin briefly
+// when they run out of work and then sleep on a condition variable until
+// more is published.
+typedef struct TaskPool {
+    int num_workers;
+    pthread_t *threads;
+    TaskDeque *deques;
+
+    pthread_mutex_t lock;   // Guards the injection queue and sleeping
+    pthread_cond_t wake;    // Idle workers wait here
+    pthread_cond_t done;    // Outside callers wait here for their batch
+    Task *injected;         // Batches submitted from outside the pool
+    int sleepers;
+    uint64_t epoch;         // Bumped whenever new work is published
+    int spin_rounds;        // TASK_SPIN_ROUNDS, or 0 when cores are oversubscribed
+    int shutdown;
+} TaskPool;
+
+int task_pool_init(TaskPool *pool, int num_workers);
+void task_pool_destroy(TaskPool *pool);
+int task_pool_size(const TaskPool *pool);
+void task_pool_run(TaskPool *pool, TaskFn fn, void *arg, int count);
+
+#endif
\ No newline at end of file
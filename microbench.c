@@ -0,0 +1,403 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+#include "mcts.h"
+#include "mcts_engine.h"
+
+// Kernel microbenchmarks, perft and search regression checks. Each kernel
+// runs on its own over a
+// fixed corpus of positions taken from seeded random games, so numbers are
+// comparable between builds. The interval after ns/op is the 95%
+// confidence interval of the mean over MICRO_TRIALS timed trials.
+//
+//   microbench                 kernels, perft to depth 9, then checks
+//   microbench kernels
+//   microbench perft [DEPTH]   move-path counts checked against reference
+//   microbench checks          search and checkpoint regression checks
+
+#define CORPUS_SEED 12345
+#define CORPUS_SIZE 1024
+#define MICRO_TRIALS 10
+#define T_95 2.262              // Student's t for 9 degrees of freedom
+#define PERFT_DEFAULT_DEPTH 9
+#define CHECK_TREE_PATH "/tmp/microbench_check.tree"
+
+// Leaf counts from the initial position. A forced pass counts as a ply and
+// a finished game counts as a leaf wherever it ends.
+static const uint64_t perft_reference[] = {
+    1, 4, 12, 56, 244, 1396, 8200, 55092, 390216, 3005288, 24571284, 212258800, 1939886636ULL
+};
+#define PERFT_KNOWN_DEPTH ((int)(sizeof(perft_reference) / sizeof(perft_reference[0])) - 1)
+
+typedef struct {
+    GameState states[CORPUS_SIZE];
+    int moves[CORPUS_SIZE];         // A legal move in each position
+    Node *expanded[CORPUS_SIZE];    // Each position expanded, with made-up statistics
+    NodeArena arena;                // Holds expanded
+    NodeArena scratch;              // Reset by the expand kernel every pass
+    MCTSConfig config;
+    RNG rng;
+} Corpus;
+
+static volatile uint64_t sink;      // Kernel results land here so none is optimised away
+
+// CORPUS
+
+// Positions with at least one move, from random games played with a fixed
+// seed, so every phase of the game is represented
+static void build_corpus(Corpus *corpus) {
+    RNG rng;
+    rng_seed(&rng, CORPUS_SEED);
+    arena_init(&corpus->arena);
+    arena_init(&corpus->scratch);
+    mcts_config_default(&corpus->config);
+
+    int count = 0;
+    while (count < CORPUS_SIZE) {
+        GameState state;
+        init_board(&state);
+        MoveList moves;
+        while (count < CORPUS_SIZE && generate_moves_or_pass(&state, &moves) > 0) {
+            int move = moves.squares[rng_bounded(&rng, moves.count)];
+            corpus->states[count] = state;
+            corpus->moves[count] = move;
+
+            Node *node = create_node(&corpus->arena, &state, -1, NULL);
+            expand(node, &corpus->arena);
+            uint64_t parent_visits = 1;
+            for (int i = 0; i < node->num_children; i++) {
+                uint64_t visits = 1 + rng_bounded(&rng, 100);
+                uint64_t half_points = rng_bounded(&rng, 2 * visits + 1);
+                node->children[i].stats = visits * NODE_VISIT + half_points;
+                parent_visits += visits;
+            }
+            node->stats = parent_visits * NODE_VISIT;
+            corpus->expanded[count] = node;
+
+            count++;
+            make_move_square(&state, move);
+        }
+    }
+}
+
+// KERNELS
+
+// Each kernel makes one pass over the corpus and returns the operations it
+// timed; *nodes gets the positions it produced or visited (0 if not counted)
+typedef uint64_t (*KernelFn)(Corpus *corpus, uint64_t *nodes);
+
+static uint64_t kernel_is_valid_move(Corpus *corpus, uint64_t *nodes) {
+    uint64_t sum = 0;
+    for (int i = 0; i < CORPUS_SIZE; i++)
+        for (int r = 0; r < SIZE; r++)
+            for (int c = 0; c < SIZE; c++)
+                sum += is_valid_move(&corpus->states[i], r, c);
+    sink += sum;
+    *nodes = CORPUS_SIZE;
+    return (uint64_t)CORPUS_SIZE * SIZE * SIZE;
+}
+
+static uint64_t kernel_has_valid_moves(Corpus *corpus, uint64_t *nodes) {
+    uint64_t sum = 0;
+    for (int i = 0; i < CORPUS_SIZE; i++) sum += has_valid_moves(&corpus->states[i]);
+    sink += sum;
+    *nodes = CORPUS_SIZE;
+    return CORPUS_SIZE;
+}
+
+static uint64_t kernel_make_move(Corpus *corpus, uint64_t *nodes) {
+    uint64_t sum = 0;
+    for (int i = 0; i < CORPUS_SIZE; i++) {
+        GameState state = corpus->states[i];
+        make_move(&state, corpus->moves[i] / SIZE, corpus->moves[i] % SIZE);
+        sum += state.black ^ state.hash;
+    }
+    sink += sum;
+    *nodes = CORPUS_SIZE;
+    return CORPUS_SIZE;
+}
+
+static uint64_t kernel_get_score(Corpus *corpus, uint64_t *nodes) {
+    uint64_t sum = 0;
+    for (int i = 0; i < CORPUS_SIZE; i++) {
+        int black, white;
+        get_score(&corpus->states[i], &black, &white);
+        sum += black - white;
+    }
+    sink += sum;
+    *nodes = CORPUS_SIZE;
+    return CORPUS_SIZE;
+}
+
+static uint64_t kernel_simulate(Corpus *corpus, uint64_t *nodes) {
+    double sum = 0.0;
+    for (int i = 0; i < CORPUS_SIZE; i++)
+        sum += simulate(&corpus->states[i], corpus->states[i].player, &corpus->rng);
+    sink += (uint64_t)sum;
+    *nodes = 0;     // Playout length is not reported by simulate
+    return CORPUS_SIZE;
+}
+
+static uint64_t kernel_expand(Corpus *corpus, uint64_t *nodes) {
+    uint64_t children = 0;
+    arena_reset(&corpus->scratch);
+    for (int i = 0; i < CORPUS_SIZE; i++) {
+        Node *node = create_node(&corpus->scratch, &corpus->states[i], -1, NULL);
+        expand(node, &corpus->scratch);
+        children += node->num_children;
+    }
+    sink += children;
+    *nodes = children;
+    return CORPUS_SIZE;
+}
+
+static uint64_t kernel_select_child(Corpus *corpus, uint64_t *nodes) {
+    uint64_t sum = 0;
+    for (int i = 0; i < CORPUS_SIZE; i++) {
+        Node *child = select_child(corpus->expanded[i], NULL, &corpus->config);
+        sum += child != NULL ? (uint64_t)child->move : 0;
+    }
+    sink += sum;
+    *nodes = CORPUS_SIZE;
+    return CORPUS_SIZE;
+}
+
+typedef struct {
+    const char *name;
+    KernelFn fn;
+    int passes;             // Corpus passes per trial, for trials of a few ms
+} Kernel;
+
+static const Kernel kernels[] = {
+    {"is_valid_move", kernel_is_valid_move, 16},
+    {"has_valid_moves", kernel_has_valid_moves, 256},
+    {"make_move", kernel_make_move, 256},
+    {"get_score", kernel_get_score, 1024},
+    {"simulate", kernel_simulate, 1},
+    {"expand", kernel_expand, 16},
+    {"select_child", kernel_select_child, 256},
+};
+#define NUM_KERNELS ((int)(sizeof(kernels) / sizeof(kernels[0])))
+
+// One untimed warm-up trial, then MICRO_TRIALS timed ones
+static void run_kernel(Corpus *corpus, const Kernel *kernel) {
+    double ns_per_op[MICRO_TRIALS];
+    double nodes_per_sec = 0.0;
+    uint64_t ops = 0;
+    for (int trial = -1; trial < MICRO_TRIALS; trial++) {
+        rng_seed(&corpus->rng, CORPUS_SEED + trial + 1);
+        uint64_t trial_ops = 0, trial_nodes = 0, nodes;
+        double start = omp_get_wtime();
+        for (int pass = 0; pass < kernel->passes; pass++) {
+            trial_ops += kernel->fn(corpus, &nodes);
+            trial_nodes += nodes;
+        }
+        double elapsed = omp_get_wtime() - start;
+        if (trial < 0) continue;
+        ops = trial_ops;
+        ns_per_op[trial] = elapsed * 1e9 / trial_ops;
+        nodes_per_sec += trial_nodes / elapsed / MICRO_TRIALS;
+    }
+
+    double mean = 0.0, var = 0.0;
+    for (int t = 0; t < MICRO_TRIALS; t++) mean += ns_per_op[t] / MICRO_TRIALS;
+    for (int t = 0; t < MICRO_TRIALS; t++) var += (ns_per_op[t] - mean) * (ns_per_op[t] - mean);
+    double ci = T_95 * sqrt(var / (MICRO_TRIALS - 1)) / sqrt(MICRO_TRIALS);
+
+    printf("%-16s | %10llu | %9.2f ns | ±%6.2f ns (%4.1f%%) | %9.3f M/s | ",
+           kernel->name, (unsigned long long)ops, mean, ci, 100.0 * ci / mean, 1e3 / mean);
+    if (nodes_per_sec > 0.0) printf("%9.3f M/s\n", nodes_per_sec / 1e6);
+    else printf("%11s\n", "-");
+}
+
+static void benchmark_kernels(void) {
+    static Corpus corpus;
+    build_corpus(&corpus);
+    printf("\n=== Kernels: %d positions, %d trials ===\n", CORPUS_SIZE, MICRO_TRIALS);
+    printf("%-16s | %10s | %12s | %19s | %11s | %11s\n",
+           "Kernel", "Ops/trial", "Time/op", "95% interval", "Ops/sec", "Nodes/sec");
+    for (int k = 0; k < NUM_KERNELS; k++) run_kernel(&corpus, &kernels[k]);
+    arena_destroy(&corpus.arena);
+    arena_destroy(&corpus.scratch);
+}
+
+// PERFT
+
+static uint64_t perft(const GameState *state, int depth) {
+    if (depth == 0) return 1;
+    MoveList moves;
+    if (generate_moves(state, &moves) == 0) {
+        GameState passed = *state;
+        pass_turn(&passed);
+        if (generate_moves(&passed, &moves) == 0) return 1;   // Game over
+        return perft(&passed, depth - 1);
+    }
+    if (depth == 1) return moves.count;
+
+    uint64_t leaves = 0;
+    for (int i = 0; i < moves.count; i++) {
+        GameState child = *state;
+        make_move_square(&child, moves.squares[i]);
+        leaves += perft(&child, depth - 1);
+    }
+    return leaves;
+}
+
+// Returns the number of depths whose count disagrees with the reference
+static int benchmark_perft(int max_depth) {
+    GameState start;
+    init_board(&start);
+    int failures = 0;
+    printf("\n=== Perft from the initial position ===\n");
+    printf("%-5s | %14s | %14s | %-6s | %10s | %12s\n",
+           "Depth", "Leaves", "Reference", "Check", "Time", "Nodes/sec");
+    for (int depth = 1; depth <= max_depth; depth++) {
+        double t0 = omp_get_wtime();
+        uint64_t leaves = perft(&start, depth);
+        double elapsed = omp_get_wtime() - t0;
+
+        const char *check = "-";
+        char reference[24] = "unknown";
+        if (depth <= PERFT_KNOWN_DEPTH) {
+            snprintf(reference, sizeof(reference), "%llu", (unsigned long long)perft_reference[depth]);
+            check = leaves == perft_reference[depth] ? "ok" : "FAIL";
+            failures += leaves != perft_reference[depth];
+        }
+        printf("%-5d | %14llu | %14s | %-6s | %8.3f s | %9.3f M/s\n", depth,
+               (unsigned long long)leaves, reference, check, elapsed,
+               elapsed > 0.0 ? leaves / elapsed / 1e6 : 0.0);
+    }
+    return failures;
+}
+
+// CHECKS
+
+// First position of a seeded random game where the side to move has
+// exactly one legal move. Returns 0 if no game reaches one.
+static int forced_move_position(GameState *state) {
+    RNG rng;
+    rng_seed(&rng, CORPUS_SEED);
+    for (int game = 0; game < 100; game++) {
+        init_board(state);
+        MoveList moves;
+        while (generate_moves_or_pass(state, &moves) > 0) {
+            if (moves.count == 1) return 1;
+            make_move_square(state, moves.squares[rng_bounded(&rng, moves.count)]);
+        }
+    }
+    return 0;
+}
+
+// Every mode must answer a forced move, even when early stop settles the
+// decision before the first playout. Returns the number of failures.
+static int check_forced_move(TaskPool *tasks) {
+    GameState state;
+    if (!forced_move_position(&state)) {
+        printf("forced move: no position found  FAIL\n");
+        return 1;
+    }
+    int expected = __builtin_ctzll(get_legal_moves(&state));
+
+    int failures = 0;
+    for (int mode = 0; mode < NUM_MODES; mode++) {
+        MCTSConfig config;
+        mcts_config_default(&config);
+        config.mode = mode;
+        MCTSEngine engine;
+        mcts_engine_init(&engine, &config, tasks);
+
+        SearchLimits limits = search_iterations(1000);
+        limits.early_stop = 1;
+        MCTSResult result;
+        int ok = mcts_engine_search(&engine, &state, &limits, &result) && result.move == expected;
+        printf("forced move, mode %d: move=%d playouts=%d  %s\n", mode, result.move,
+               result.timing.iterations, ok ? "ok" : "FAIL");
+        failures += !ok;
+        mcts_engine_destroy(&engine);
+    }
+    return failures;
+}
+
+// Whether two trees hold the same nodes in the same order
+static int same_tree(const Node *a, const Node *b) {
+    if (a->stats != b->stats || a->move != b->move || a->proven != b->proven ||
+        a->player_just_moved != b->player_just_moved || a->num_children != b->num_children ||
+        (a->expand_state == NODE_EXPANDED) != (b->expand_state == NODE_EXPANDED) ||
+        a->black != b->black || a->white != b->white || a->hash != b->hash)
+        return 0;
+    for (int i = 0; i < a->num_children; i++)
+        if (!same_tree(&a->children[i], &b->children[i])) return 0;
+    return 1;
+}
+
+// A searched tree must load back node for node, and a damaged checkpoint
+// must leave the tree it was loaded into as it was. Returns the number of
+// failures.
+static int check_checkpoint(TaskPool *tasks) {
+    MCTSConfig config;
+    mcts_config_default(&config);
+    MCTSEngine engine;
+    mcts_engine_init(&engine, &config, tasks);
+    GameState start;
+    init_board(&start);
+    SearchLimits limits = search_iterations(5000);
+    mcts_engine_search(&engine, &start, &limits, NULL);
+
+    MCTSTree loaded;
+    tree_init(&loaded, &start);
+    int saved = tree_save(&engine.tree, CHECK_TREE_PATH);
+    int round_trip = saved && tree_load(&loaded, CHECK_TREE_PATH) &&
+                     same_tree(engine.tree.root, loaded.root);
+    printf("checkpoint round trip: %zu bytes of nodes  %s\n", tree_bytes_used(&engine.tree),
+           round_trip ? "ok" : "FAIL");
+
+    // Spoil the magic: the load must fail and keep the tree
+    Node *before = loaded.root;
+    int rejected = 0;
+    FILE *file = fopen(CHECK_TREE_PATH, "r+b");
+    if (file != NULL) {
+        fputc('X', file);
+        fclose(file);
+        rejected = !tree_load(&loaded, CHECK_TREE_PATH) && loaded.root == before &&
+                   same_tree(engine.tree.root, loaded.root);
+    }
+    printf("checkpoint damaged file rejected  %s\n", rejected ? "ok" : "FAIL");
+
+    remove(CHECK_TREE_PATH);
+    tree_destroy(&loaded);
+    mcts_engine_destroy(&engine);
+    return !round_trip + !rejected;
+}
+
+// Returns the number of failed checks
+static int run_checks(void) {
+    printf("\n=== Regression checks ===\n");
+    TaskPool tasks;
+    task_pool_init(&tasks, 2);
+    int failures = check_forced_move(&tasks);
+    failures += check_checkpoint(&tasks);
+    task_pool_destroy(&tasks);
+    return failures;
+}
+
+int main(int argc, char *argv[]) {
+    const char *mode = argc > 1 ? argv[1] : "all";
+    int depth = argc > 2 ? atoi(argv[2]) : PERFT_DEFAULT_DEPTH;
+    int run_kernels = strcmp(mode, "all") == 0 || strcmp(mode, "kernels") == 0;
+    int run_perft = strcmp(mode, "all") == 0 || strcmp(mode, "perft") == 0;
+    int run_check = strcmp(mode, "all") == 0 || strcmp(mode, "checks") == 0;
+    if ((!run_kernels && !run_perft && !run_check) || depth < 1) {
+        fprintf(stderr, "usage: %s [all|kernels|perft|checks] [perft depth]\n", argv[0]);
+        return 1;
+    }
+
+    if (run_kernels) benchmark_kernels();
+    int failures = run_perft ? benchmark_perft(depth) : 0;
+    if (failures > 0) printf("\nperft: %d depth(s) FAILED\n", failures);
+    int check_failures = run_check ? run_checks() : 0;
+    if (check_failures > 0) printf("\nchecks: %d FAILED\n", check_failures);
+    return failures + check_failures > 0;
+}
\ No newline at end of file
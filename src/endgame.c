@@ -0,0 +1,174 @@
+#include "endgame.h"
+
+// Exact endgame solver. Scores are final disc differences from the point
+// of view of the side to move (own), searched with negamax alpha-beta.
+// Positions with at most 4 empties skip move generation entirely and try
+// the remaining squares directly, odd-parity regions first.
+
+#define FASTEST_FIRST_EMPTIES 7   // Mobility ordering above this many empties
+
+static const uint64_t quadrant_mask[4] = {
+    0x000000000F0F0F0FULL, 0x00000000F0F0F0F0ULL,
+    0x0F0F0F0F00000000ULL, 0xF0F0F0F000000000ULL
+};
+
+static inline int final_score(uint64_t own, uint64_t opp) {
+    return __builtin_popcountll(own) - __builtin_popcountll(opp);
+}
+
+// Squares in quadrants holding an odd number of empties; playing there
+// first tends to leave the opponent the last move of a region
+static inline uint64_t odd_parity_mask(uint64_t empty) {
+    uint64_t mask = 0;
+    for (int q = 0; q < 4; q++)
+        if (__builtin_popcountll(empty & quadrant_mask[q]) & 1)
+            mask |= quadrant_mask[q];
+    return mask;
+}
+
+// One empty square left
+static int solve_1(uint64_t own, uint64_t opp, int sq) {
+    int score = final_score(own, opp);
+    uint64_t flips = bitboard_flips(own, opp, sq);
+    if (flips) return score + 2 * __builtin_popcountll(flips) + 1;
+    flips = bitboard_flips(opp, own, sq);
+    if (flips) return score - 2 * __builtin_popcountll(flips) - 1;
+    return score;
+}
+
+// Two to four empty squares, given in parity order
+static int solve_small(uint64_t own, uint64_t opp, int alpha, int beta,
+                       const int *squares, int n, int passed) {
+    int best = -ENDGAME_SCORE_MAX - 1;
+    int rest[4];
+
+    for (int i = 0; i < n; i++) {
+        int sq = squares[i];
+        uint64_t flips = bitboard_flips(own, opp, sq);
+        if (flips == 0) continue;
+
+        int k = 0;
+        for (int j = 0; j < n; j++)
+            if (j != i) rest[k++] = squares[j];
+
+        uint64_t new_own = opp ^ flips;
+        uint64_t new_opp = own | flips | SQUARE_BIT(sq);
+        int score = k == 1 ? -solve_1(new_own, new_opp, rest[0])
+                           : -solve_small(new_own, new_opp, -beta, -alpha, rest, k, 0);
+        if (score > best) {
+            best = score;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) return best;
+            }
+        }
+    }
+
+    if (best == -ENDGAME_SCORE_MAX - 1) {
+        if (passed) return final_score(own, opp);
+        return -solve_small(opp, own, -beta, -alpha, squares, n, 1);
+    }
+    return best;
+}
+
+static int solve(uint64_t own, uint64_t opp, int alpha, int beta, int passed) {
+    uint64_t empty = ~(own | opp);
+    int n = __builtin_popcountll(empty);
+
+    if (n == 0) return final_score(own, opp);
+    if (n == 1) return solve_1(own, opp, __builtin_ctzll(empty));
+    if (n <= 4) {
+        int squares[4], k = 0;
+        uint64_t odd = empty & odd_parity_mask(empty);
+        for (uint64_t b = odd; b; b &= b - 1) squares[k++] = __builtin_ctzll(b);
+        for (uint64_t b = empty & ~odd; b; b &= b - 1) squares[k++] = __builtin_ctzll(b);
+        return solve_small(own, opp, alpha, beta, squares, n, 0);
+    }
+
+    uint64_t moves = bitboard_moves(own, opp);
+    if (moves == 0) {
+        if (passed || bitboard_moves(opp, own) == 0) return final_score(own, opp);
+        return -solve(opp, own, -beta, -alpha, 1);
+    }
+
+    // Order moves: parity first, then (deep enough) fewest opponent replies
+    int order[SIZE * SIZE], keys[SIZE * SIZE], count = 0;
+    uint64_t odd = odd_parity_mask(empty);
+    for (uint64_t b = moves; b; b &= b - 1) {
+        int sq = __builtin_ctzll(b);
+        int key = (SQUARE_BIT(sq) & odd) ? 0 : 1;
+        if (n > FASTEST_FIRST_EMPTIES) {
+            uint64_t flips = bitboard_flips(own, opp, sq);
+            key += 2 * __builtin_popcountll(bitboard_moves(opp ^ flips, own | flips | SQUARE_BIT(sq)));
+        }
+        int i = count++;
+        while (i > 0 && keys[i - 1] > key) {
+            keys[i] = keys[i - 1];
+            order[i] = order[i - 1];
+            i--;
+        }
+        keys[i] = key;
+        order[i] = sq;
+    }
+
+    int best = -ENDGAME_SCORE_MAX - 1;
+    for (int i = 0; i < count; i++) {
+        int sq = order[i];
+        uint64_t flips = bitboard_flips(own, opp, sq);
+        int score = -solve(opp ^ flips, own | flips | SQUARE_BIT(sq), -beta, -alpha, 0);
+        if (score > best) {
+            best = score;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) break;
+            }
+        }
+    }
+    return best;
+}
+
+static inline void split_state(const GameState *state, uint64_t *own, uint64_t *opp) {
+    *own = state->player == BLACK ? state->black : state->white;
+    *opp = state->player == BLACK ? state->white : state->black;
+}
+
+int count_empties(const GameState *state) {
+    return __builtin_popcountll(~(state->black | state->white));
+}
+
+// Disc difference for the side to move under perfect play. Like any
+// alpha-beta result it is exact inside (alpha, beta) and a bound outside.
+int solve_endgame(const GameState *state, int alpha, int beta) {
+    uint64_t own, opp;
+    split_state(state, &own, &opp);
+    return solve(own, opp, alpha, beta, 0);
+}
+
+// Win (1), draw (0) or loss (-1) for the side to move, using a null window
+int solve_endgame_wld(const GameState *state) {
+    int score = solve_endgame(state, -1, 1);
+    return score > 0 ? 1 : (score < 0 ? -1 : 0);
+}
+
+// Exact score and best square for the side to move (-1 if it must pass)
+int solve_endgame_best(const GameState *state, int *best_sq) {
+    uint64_t own, opp;
+    split_state(state, &own, &opp);
+    *best_sq = -1;
+
+    uint64_t moves = bitboard_moves(own, opp);
+    if (moves == 0) return solve(own, opp, -ENDGAME_SCORE_MAX, ENDGAME_SCORE_MAX, 0);
+
+    int best = -ENDGAME_SCORE_MAX - 1;
+    for (uint64_t b = moves; b; b &= b - 1) {
+        int sq = __builtin_ctzll(b);
+        uint64_t flips = bitboard_flips(own, opp, sq);
+        int score = -solve(opp ^ flips, own | flips | SQUARE_BIT(sq),
+                           -ENDGAME_SCORE_MAX, -best, 0);
+        if (score > best) {
+            best = score;
+            *best_sq = sq;
+        }
+    }
+    return best;
+}
\ No newline at end of file
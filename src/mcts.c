@@ -1,77 +1,40 @@
 #include "mcts.h"
 
-// UCB1 node selection logic
-double ucb1(Node *node) {
-    if (node->visits == 0) return INFINITY;
-    double exploitation = node->wins / node->visits;
-    double exploration = UCB_CONSTANT * sqrt(log(node->parent->visits) / node->visits);
-    return exploitation + exploration;
-}
-
-// MCTS selection phase
-Node* select_child(Node *node) {
-    Node *best = NULL;
-    double best_ucb = -INFINITY;
-    for (int i = 0; i < node->num_children; i++) {
-        double ucb = ucb1(node->children[i]);
-        if (ucb > best_ucb) {
-            best_ucb = ucb;
-            best = node->children[i];
-        }
+// MCTS selection phase; scores every child in one vectorized pass. When
+// every reply is a proven loss the node is settled as won and the first
+// (proven) child returned, so the descent stops there.
+Node* select_child(Node *node, TranspositionTable *tt, const MCTSConfig *config) {
+    int best = ucb_select(node, tt, config->ucb_constant);
+    if (best < 0) {
+        settle_proof(node);
+        best = 0;
     }
-    return best;
+    return &node->children[best];
 }
 
 // MCTS expansion phase
-void expand(Node *node) {
-    GameState *state = &node->state;
-    int count = 0;
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            if (is_valid_move(state, i, j))
-                count++;
-
-    if (count == 0) return;
-
-    node->children = malloc(count * sizeof(Node*));
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            if (is_valid_move(state, i, j)) {
-                GameState new_state = *state;
-                make_move(&new_state, i, j);
-                node->children[node->num_children++] = create_node(&new_state, i, j, node);
-            }
-        }
+void expand(Node *node, NodeArena *arena) {
+    GameState state = node_state(node);
+    MoveList moves;
+    node->expand_state = NODE_EXPANDED;
+    if (generate_moves(&state, &moves) == 0) return;
+
+    node->children = arena_alloc(arena, moves.count * sizeof(Node));
+    for (int i = 0; i < moves.count; i++) {
+        int sq = moves.squares[i];
+        GameState new_state = state;
+        make_move_square(&new_state, sq);
+        init_node(&node->children[i], &new_state, sq, node);
     }
+    node->num_children = (unsigned char)moves.count;
 }
 
 // MCTS simulation phase
-double simulate(GameState *state, int original_player, unsigned int *seed, int include_seed) {
+double simulate(GameState *state, int original_player, RNG *rng) {
     GameState sim = *state;
-    while (1) {
-        if (!has_valid_moves(&sim)) {
-            sim.player = opponent(sim.player);
-            if (!has_valid_moves(&sim))
-                break;
-        }
-        int board_size = SIZE * SIZE;
-        int moves[board_size][2], count = 0;
-        for (int i = 0; i < SIZE; i++)
-            for (int j = 0; j < SIZE; j++)
-                if (is_valid_move(&sim, i, j)) {
-                    moves[count][0] = i;
-                    moves[count][1] = j;
-                    count++;
-                }
-
-        if (count == 0) break;
-
-        int idx;
-        if (include_seed)
-            idx = rand_r(seed) % count;
-        else
-            idx = rand() % count;
-        make_move(&sim, moves[idx][0], moves[idx][1]);
+    MoveList moves;
+    while (generate_moves_or_pass(&sim, &moves) > 0) {
+        make_move_square(&sim, moves.squares[rng_bounded(rng, moves.count)]);
     }
 
     int black, white;
@@ -89,58 +52,142 @@ double simulate(GameState *state, int original_player, unsigned int *seed, int i
     }
 }
 
+// Settle node from its fully expanded children: one winning reply makes
+// it lost for whoever moved into it, and once every reply is settled the
+// best of them decides. Returns 1 if node has just become proven.
+int settle_proof(Node *node) {
+    if (node_proven(node) != PROVEN_NONE || node->num_children == 0) return 0;
+    int all_proven = 1, any_draw = 0, result = PROVEN_NONE;
+    for (int i = 0; i < node->num_children; i++) {
+        int p = node_proven(&node->children[i]);
+        if (p == PROVEN_WIN) { result = PROVEN_LOSS; break; }
+        if (p == PROVEN_NONE) all_proven = 0;
+        if (p == PROVEN_DRAW) any_draw = 1;
+    }
+    if (result == PROVEN_NONE && all_proven)
+        result = any_draw ? PROVEN_DRAW : PROVEN_WIN;
+    if (result == PROVEN_NONE) return 0;
+
+    __atomic_store_n(&node->proven, (unsigned char)result, __ATOMIC_RELAXED);
+    return 1;
+}
+
+// Settle node and walk up while that settles its ancestors too
+static void propagate_proof(Node *node) {
+    while (node != NULL && settle_proof(node))
+        node = node->parent;
+}
+
+// Exact value of a leaf, if known or cheap enough to solve: the result is
+// from the side to move's perspective, as simulate() reports it. Newly
+// solved leaves are marked proven and the proof is pushed up the tree.
+int solve_leaf(Node *node, const MCTSConfig *config, double *result) {
+    int proven = node_proven(node);
+    if (proven == PROVEN_NONE) {
+        GameState state = node_state(node);
+        int game_over = bitboard_moves(state.black, state.white) == 0 &&
+                        bitboard_moves(state.white, state.black) == 0;
+        if (count_empties(&state) > config->endgame_empties && !game_over) return 0;
+
+        int wld = solve_endgame_wld(&state);
+        proven = wld > 0 ? PROVEN_LOSS : (wld < 0 ? PROVEN_WIN : PROVEN_DRAW);
+        __atomic_store_n(&node->proven, (unsigned char)proven, __ATOMIC_RELAXED);
+        propagate_proof(node->parent);
+    }
+
+    *result = proven == PROVEN_LOSS ? 1.0 : (proven == PROVEN_WIN ? 0.0 : 0.5);
+    return 1;
+}
+
+// Exact value where available, a random rollout otherwise
+double evaluate_leaf(Node *node, const MCTSConfig *config, RNG *rng) {
+    double result;
+    if (solve_leaf(node, config, &result)) return result;
+    GameState state = node_state(node);
+    return simulate(&state, state.player, rng);
+}
+
 // MCTS backpropagation approach
-void backpropagate(Node *node, double result) {
-    int sim_player = node->state.player;
+void backpropagate(Node *node, double result, TranspositionTable *tt) {
+    int sim_player = node_player(node);
     while (node != NULL) {
-        node->visits++;
-        if (node->player_just_moved == sim_player) node->wins += result;
-        else node->wins += (1.0 - result);
+        double add = node->player_just_moved == sim_player ? result : 1.0 - result;
+        node_add_stats(node, stats_result(add));
+        if (tt != NULL) tt_update(tt, node->hash, add);
         node = node->parent;
     }
 }
 
-// MCTS sequential approach
-MCTSTiming mcts_sequential(Node *root, int iterations) {
-    MCTSTiming timing = {0};
+// Backpropagate count playouts at once; wins is their total from the
+// perspective of the player to move at node. Each node on the path takes
+// one atomic add however large the batch.
+void backpropagate_batch(Node *node, int count, double wins) {
+    int sim_player = node_player(node);
+    uint64_t half_points = (uint64_t)(wins * 2.0 + 0.5);
+    uint64_t own = (uint64_t)count * NODE_VISIT + half_points;
+    uint64_t other = (uint64_t)count * NODE_VISIT + (2 * (uint64_t)count - half_points);
+    while (node != NULL) {
+        node_add_stats(node, node->player_just_moved == sim_player ? own : other);
+        node = node->parent;
+    }
+}
 
-    struct timespec start, end;
-    
-    for (int i = 0; i < iterations; i++) {
+// Sequential search loop, expanded once with probes and once without.
+// Returns the iterations run.
+PROBE_INLINE int sequential_loop(Node *root, NodeArena *arena, TranspositionTable *tt,
+                                 const MCTSConfig *config, SearchBudget *budget, RNG *rng,
+                                 PhaseProbe *probe, const int instrumented) {
+    int i;
+    for (i = 0; !budget_done(budget, root, i); i++) {
+        int sampled = PROBE_SAMPLE(instrumented, config->probe_interval, i);
+        uint64_t mark = sampled ? probe_ticks() : 0;
         Node *node = root;
         
         // Selection
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        while (node->num_children > 0) {
-            node = select_child(node);
+        while (node->num_children > 0 && node_proven(node) == PROVEN_NONE) {
+            node = select_child(node, tt, config);
         }
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        timing.selection += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if (sampled) probe_lap(probe, PHASE_SELECTION, &mark);
         
         // Expansion
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        if (node->visits > 0 && has_valid_moves(&node->state)) {
-            expand(node);
+        if (node_visits(node) > 0 && node_proven(node) == PROVEN_NONE) {
+            expand(node, arena);
             if (node->num_children > 0) {
-                node = node->children[rand() % node->num_children];
+                node = &node->children[rng_bounded(rng, node->num_children)];
             }
         }
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        timing.expansion += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if (sampled) probe_lap(probe, PHASE_EXPANSION, &mark);
         
         // Simulation
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        double result = simulate(&node->state, node->state.player, 0, 0);
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        timing.simulation += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        double result = evaluate_leaf(node, config, rng);
+        if (sampled) probe_lap(probe, PHASE_SIMULATION, &mark);
         
         // Backpropagation
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        backpropagate(node, result);
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        timing.backpropagation += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        backpropagate(node, result, tt);
+        if (sampled) {
+            probe_lap(probe, PHASE_BACKPROPAGATION, &mark);
+            probe->samples++;
+        }
     }
+    return i;
+}
+
+// MCTS sequential approach
+MCTSTiming mcts_sequential(Node *root, NodePool *pool, TranspositionTable *tt, const MCTSConfig *config,
+                           const SearchLimits *limits, RNG *rng) {
+    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0, 0};
+    NodeArena *arena = node_pool_arena(pool);
+
+    SearchBudget budget;
+    budget_start(&budget, limits);
+    PhaseProbe probe;
+    probe_start(&probe);
 
-    timing.total = timing.selection + timing.expansion + timing.simulation + timing.backpropagation;
+    timing.iterations = PROBE_DISPATCH(config,
+        sequential_loop(root, arena, tt, config, &budget, rng, &probe, 1),
+        sequential_loop(root, arena, tt, config, &budget, rng, &probe, 0));
+
+    probe_finish(&probe, timing.iterations, &timing);
+    timing.total = omp_get_wtime() - probe.start_time;
     return timing;
-}
+}
\ No newline at end of file
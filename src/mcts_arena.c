@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "mcts_arena.h"
+
+#define ARENA_ALIGN 16
+
+// ARENA FUNCTIONS
+
+static ArenaBlock* new_block(size_t min_size) {
+    size_t size = min_size > ARENA_BLOCK_SIZE ? min_size : ARENA_BLOCK_SIZE;
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + size);
+    if (block == NULL) return NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+void arena_init(NodeArena *arena) {
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+// Bump-allocate size bytes, moving on to the next (possibly new) block when
+// the current one is full
+void* arena_alloc(NodeArena *arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    ArenaBlock *block = arena->current;
+    while (block != NULL && block->used + size > block->size) {
+        if (block->next == NULL) break;
+        block = block->next;
+        block->used = 0;
+    }
+
+    if (block == NULL || block->used + size > block->size) {
+        ArenaBlock *fresh = new_block(size);
+        if (fresh == NULL) return NULL;
+        if (block == NULL) arena->first = fresh;
+        else {
+            fresh->next = block->next;
+            block->next = fresh;
+        }
+        block = fresh;
+    }
+
+    arena->current = block;
+    void *ptr = block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+// Release everything allocated from the arena in O(1); blocks are kept
+void arena_reset(NodeArena *arena) {
+    arena->current = arena->first;
+    if (arena->first != NULL) arena->first->used = 0;
+}
+
+void arena_destroy(NodeArena *arena) {
+    ArenaBlock *block = arena->first;
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena_init(arena);
+}
+
+size_t arena_bytes_used(const NodeArena *arena) {
+    size_t total = 0;
+    for (ArenaBlock *block = arena->first; block != NULL; block = block->next) {
+        total += block->used;
+        if (block == arena->current) break;
+    }
+    return total;
+}
+
+
+// POOL FUNCTIONS
+
+int node_pool_init(NodePool *pool, int num_arenas) {
+    pool->arenas = NULL;
+    pool->num_arenas = 0;
+    return node_pool_reserve(pool, num_arenas);
+}
+
+// Make sure there is an arena for every thread id below num_arenas.
+// Must be called outside of parallel regions. Returns 0, leaving the pool
+// as it was, if the arena array cannot be grown.
+int node_pool_reserve(NodePool *pool, int num_arenas) {
+    if (num_arenas <= pool->num_arenas) return 1;
+
+    NodeArena *arenas = aligned_alloc(_Alignof(NodeArena), num_arenas * sizeof(NodeArena));
+    if (arenas == NULL) return 0;
+    if (pool->num_arenas > 0)
+        memcpy(arenas, pool->arenas, pool->num_arenas * sizeof(NodeArena));
+    for (int i = pool->num_arenas; i < num_arenas; i++)
+        arena_init(&arenas[i]);
+
+    free(pool->arenas);
+    pool->arenas = arenas;
+    pool->num_arenas = num_arenas;
+    return 1;
+}
+
+// Arena belonging to the calling OpenMP thread
+NodeArena* node_pool_arena(NodePool *pool) {
+    return &pool->arenas[omp_get_thread_num() % pool->num_arenas];
+}
+
+// Arena belonging to a task pool worker
+NodeArena* node_pool_arena_at(NodePool *pool, int worker) {
+    return &pool->arenas[worker % pool->num_arenas];
+}
+
+// Drop every node allocated from the pool at once
+void node_pool_reset(NodePool *pool) {
+    for (int i = 0; i < pool->num_arenas; i++)
+        arena_reset(&pool->arenas[i]);
+}
+
+void node_pool_destroy(NodePool *pool) {
+    for (int i = 0; i < pool->num_arenas; i++)
+        arena_destroy(&pool->arenas[i]);
+    free(pool->arenas);
+    pool->arenas = NULL;
+    pool->num_arenas = 0;
+}
+
+size_t node_pool_bytes_used(const NodePool *pool) {
+    size_t total = 0;
+    for (int i = 0; i < pool->num_arenas; i++)
+        total += arena_bytes_used(&pool->arenas[i]);
+    return total;
+}
\ No newline at end of file
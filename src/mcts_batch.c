@@ -0,0 +1,74 @@
+#include "mcts_batch.h"
+
+#define FILE_A 0x0101010101010101ULL
+#define FILE_H 0x8080808080808080ULL
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_X86 1
+#else
+#define BATCH_X86 0
+#endif
+
+#if BATCH_X86
+// AVX-512: 8 games per batch, one zmm register per board half
+#define BATCH_LANES 8
+#define BATCH_NAME(name) batch_##name##_avx512
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#include "mcts_batch_kernel.h"
+#pragma GCC pop_options
+#undef BATCH_LANES
+#undef BATCH_NAME
+
+// AVX2: 4 games per batch, one ymm register per board half
+#define BATCH_LANES 4
+#define BATCH_NAME(name) batch_##name##_avx2
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#include "mcts_batch_kernel.h"
+#pragma GCC pop_options
+#undef BATCH_LANES
+#undef BATCH_NAME
+#endif
+
+// Scalar fallback, and the only kernel off x86: one game at a time
+#define BATCH_LANES 1
+#define BATCH_NAME(name) batch_##name##_scalar
+#include "mcts_batch_kernel.h"
+#undef BATCH_LANES
+#undef BATCH_NAME
+
+typedef void (*BatchKernel)(const GameState *states, int count, double *results, RNG *rng);
+
+// Widest kernel the CPU supports, and how many games it advances at once.
+// Chosen once at load time rather than on every batch.
+static BatchKernel batch_kernel = batch_simulate_scalar;
+static int batch_lanes = 1;
+
+__attribute__((constructor))
+static void select_batch_kernel(void) {
+#if BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        batch_kernel = batch_simulate_avx512;
+        batch_lanes = 8;
+    } else if (__builtin_cpu_supports("avx2")) {
+        batch_kernel = batch_simulate_avx2;
+        batch_lanes = 4;
+    }
+#endif
+}
+
+// Number of games the batch kernel advances in lockstep
+int simulate_batch_lanes(void) {
+    return batch_lanes;
+}
+
+// Play count random games to the end, one from each of states. results[i]
+// is 1.0 / 0.5 / 0.0 for a win / draw / loss of states[i].player.
+void simulate_batch(const GameState *states, int count, double *results, RNG *rng) {
+    for (int i = 0; i < count; i += batch_lanes) {
+        int n = count - i < batch_lanes ? count - i : batch_lanes;
+        batch_kernel(states + i, n, results + i, rng);
+    }
+}
\ No newline at end of file
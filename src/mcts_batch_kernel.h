@@ -0,0 +1,128 @@
+// Lockstep playout kernel, included by mcts_batch.c once per instruction
+// set. The includer defines BATCH_LANES and BATCH_NAME(name), which gives
+// every function in this file a per-instruction-set name.
+//
+// Each lane of a BatchVec holds one game as (side to move, other side)
+// bitboards, so the whole batch is a struct-of-arrays board layout.
+
+typedef uint64_t BATCH_NAME(vec) __attribute__((vector_size(BATCH_LANES * sizeof(uint64_t))));
+#define BatchVec BATCH_NAME(vec)
+
+static inline BatchVec BATCH_NAME(fill_left)(BatchVec gen, BatchVec pro, int s) {
+    gen |= pro & (gen << s);
+    pro &= pro << s;
+    gen |= pro & (gen << (2 * s));
+    pro &= pro << (2 * s);
+    gen |= pro & (gen << (4 * s));
+    return gen;
+}
+
+static inline BatchVec BATCH_NAME(fill_right)(BatchVec gen, BatchVec pro, int s) {
+    gen |= pro & (gen >> s);
+    pro &= pro >> s;
+    gen |= pro & (gen >> (2 * s));
+    pro &= pro >> (2 * s);
+    gen |= pro & (gen >> (4 * s));
+    return gen;
+}
+
+// Legal moves along one direction pair (s, -s)
+static inline BatchVec BATCH_NAME(dir_moves)(BatchVec own, BatchVec opp, int s,
+                                              uint64_t lmask, uint64_t rmask) {
+    BatchVec empty = ~(own | opp);
+    BatchVec run = BATCH_NAME(fill_left)(own, opp & lmask, s) & opp;
+    BatchVec moves = (run << s) & lmask & empty;
+    run = BATCH_NAME(fill_right)(own, opp & rmask, s) & opp;
+    return moves | ((run >> s) & rmask & empty);
+}
+
+// Flips along one direction pair (s, -s) for a single move bit per lane
+static inline BatchVec BATCH_NAME(dir_flips)(BatchVec own, BatchVec opp, BatchVec move, int s,
+                                              uint64_t lmask, uint64_t rmask) {
+    BatchVec run = BATCH_NAME(fill_left)(move, opp & lmask, s);
+    BatchVec flips = run & opp & (BatchVec)(((run << s) & lmask & own) != 0);
+    run = BATCH_NAME(fill_right)(move, opp & rmask, s);
+    return flips | (run & opp & (BatchVec)(((run >> s) & rmask & own) != 0));
+}
+
+static inline BatchVec BATCH_NAME(legal_moves)(BatchVec own, BatchVec opp) {
+    return BATCH_NAME(dir_moves)(own, opp, 1, ~FILE_A, ~FILE_H)
+         | BATCH_NAME(dir_moves)(own, opp, 7, ~FILE_H, ~FILE_A)
+         | BATCH_NAME(dir_moves)(own, opp, 8, ~0ULL, ~0ULL)
+         | BATCH_NAME(dir_moves)(own, opp, 9, ~FILE_A, ~FILE_H);
+}
+
+static inline BatchVec BATCH_NAME(flips)(BatchVec own, BatchVec opp, BatchVec move) {
+    return BATCH_NAME(dir_flips)(own, opp, move, 1, ~FILE_A, ~FILE_H)
+         | BATCH_NAME(dir_flips)(own, opp, move, 7, ~FILE_H, ~FILE_A)
+         | BATCH_NAME(dir_flips)(own, opp, move, 8, ~0ULL, ~0ULL)
+         | BATCH_NAME(dir_flips)(own, opp, move, 9, ~FILE_A, ~FILE_H);
+}
+
+// Play count (<= BATCH_LANES) random games to the end in lockstep
+static void BATCH_NAME(simulate)(const GameState *states, int count, double *results, RNG *rng) {
+    BatchVec own = {0}, opp = {0}, move = {0};
+    int swapped[BATCH_LANES] = {0};  // lane's side to move is not its start player
+    int done[BATCH_LANES] = {0};
+    int live = count;
+
+    for (int l = 0; l < BATCH_LANES; l++) {
+        if (l < count) {
+            own[l] = states[l].player == BLACK ? states[l].black : states[l].white;
+            opp[l] = states[l].player == BLACK ? states[l].white : states[l].black;
+        } else {
+            done[l] = 1;
+        }
+    }
+
+    while (live > 0) {
+        BatchVec moves = BATCH_NAME(legal_moves)(own, opp);
+        BatchVec replies = {0};
+        int need_pass = 0;
+        for (int l = 0; l < BATCH_LANES; l++)
+            need_pass |= !done[l] && moves[l] == 0;
+        if (need_pass)
+            replies = BATCH_NAME(legal_moves)(opp, own);
+
+        // Pick a random move per lane, passing or retiring lanes that are stuck
+        for (int l = 0; l < BATCH_LANES; l++) {
+            uint64_t m = moves[l];
+            if (!done[l] && m == 0) {
+                if (replies[l] == 0) {
+                    done[l] = 1;
+                    live--;
+                } else {
+                    uint64_t t = own[l];
+                    own[l] = opp[l];
+                    opp[l] = t;
+                    swapped[l] ^= 1;
+                    m = replies[l];
+                }
+            }
+            if (done[l]) {
+                move[l] = 0;
+                continue;
+            }
+            int k = rng_bounded(rng, __builtin_popcountll(m));
+            while (k--) m &= m - 1;
+            move[l] = m & -m;
+        }
+
+        // Finished lanes have no move bit, so they only swap sides here
+        BatchVec flips = BATCH_NAME(flips)(own, opp, move);
+        BatchVec next = opp ^ flips;
+        opp = own | move | flips;
+        own = next;
+        for (int l = 0; l < BATCH_LANES; l++)
+            swapped[l] ^= 1;
+    }
+
+    // Score from the perspective of each game's starting player
+    for (int l = 0; l < count; l++) {
+        int mine = __builtin_popcountll(swapped[l] ? opp[l] : own[l]);
+        int theirs = __builtin_popcountll(swapped[l] ? own[l] : opp[l]);
+        results[l] = mine > theirs ? 1.0 : (mine < theirs ? 0.0 : 0.5);
+    }
+}
+
+#undef BatchVec
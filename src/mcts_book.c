@@ -0,0 +1,169 @@
+#define _POSIX_C_SOURCE 200809L   // fstat, mmap
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mcts_book.h"
+
+// The eight board symmetries. Symmetry s transposes when bit 2 is set, then
+// mirrors the rows when bit 1 is set, then the columns when bit 0 is set.
+
+static uint64_t flip_rows(uint64_t b) {
+    return __builtin_bswap64(b);
+}
+
+static uint64_t flip_columns(uint64_t b) {
+    b = ((b >> 1) & 0x5555555555555555ULL) | ((b & 0x5555555555555555ULL) << 1);
+    b = ((b >> 2) & 0x3333333333333333ULL) | ((b & 0x3333333333333333ULL) << 2);
+    b = ((b >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((b & 0x0f0f0f0f0f0f0f0fULL) << 4);
+    return b;
+}
+
+// Swap rows and columns: (r, c) -> (c, r)
+static uint64_t transpose(uint64_t b) {
+    uint64_t t;
+    t = 0x0f0f0f0f00000000ULL & (b ^ (b << 28));
+    b ^= t ^ (t >> 28);
+    t = 0x3333000033330000ULL & (b ^ (b << 14));
+    b ^= t ^ (t >> 14);
+    t = 0x5500550055005500ULL & (b ^ (b << 7));
+    b ^= t ^ (t >> 7);
+    return b;
+}
+
+static uint64_t transform_board(uint64_t b, int sym) {
+    if (sym & 4) b = transpose(b);
+    if (sym & 2) b = flip_rows(b);
+    if (sym & 1) b = flip_columns(b);
+    return b;
+}
+
+// Where square sq lands under symmetry sym
+int book_transform_square(int sq, int sym) {
+    int r = sq / SIZE, c = sq % SIZE;
+    if (sym & 4) { int t = r; r = c; c = t; }
+    if (sym & 2) r = SIZE - 1 - r;
+    if (sym & 1) c = SIZE - 1 - c;
+    return SQUARE(r, c);
+}
+
+// Inverse of book_transform_square
+int book_untransform_square(int sq, int sym) {
+    int r = sq / SIZE, c = sq % SIZE;
+    if (sym & 1) c = SIZE - 1 - c;
+    if (sym & 2) r = SIZE - 1 - r;
+    if (sym & 4) { int t = r; r = c; c = t; }
+    return SQUARE(r, c);
+}
+
+// Reduce state to the representative of its symmetry class: the transform
+// with the smallest (black, white) pair. Returns the symmetry applied.
+int book_canonical(const GameState *state, GameState *canonical) {
+    int best_sym = 0;
+    uint64_t best_black = state->black, best_white = state->white;
+    for (int sym = 1; sym < BOOK_SYMMETRIES; sym++) {
+        uint64_t black = transform_board(state->black, sym);
+        uint64_t white = transform_board(state->white, sym);
+        if (black < best_black || (black == best_black && white < best_white)) {
+            best_sym = sym;
+            best_black = black;
+            best_white = white;
+        }
+    }
+    canonical->black = best_black;
+    canonical->white = best_white;
+    canonical->player = state->player;
+    canonical->hash = compute_hash(canonical);
+    return best_sym;
+}
+
+static int compare_entries(const void *a, const void *b) {
+    uint64_t ka = ((const BookEntry *)a)->key, kb = ((const BookEntry *)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+// Sort entries by key, drop repeated keys (a pass can reach one position at
+// two depths) and write them as a book file in one sequential pass.
+// Returns 0 if the file cannot be written.
+int book_write(const char *path, BookEntry *entries, size_t count, int plies, int iterations) {
+    qsort(entries, count, sizeof(BookEntry), compare_entries);
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++)
+        if (kept == 0 || entries[kept - 1].key != entries[i].key)
+            entries[kept++] = entries[i];
+    count = kept;
+
+    BookHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BOOK_MAGIC, sizeof(header.magic));
+    header.version = BOOK_VERSION;
+    header.entry_size = sizeof(BookEntry);
+    header.count = count;
+    header.plies = plies;
+    header.iterations = iterations;
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return 0;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(entries, sizeof(BookEntry), count, file) == count;
+    return fclose(file) == 0 && ok;
+}
+
+// Map the book at path. Returns 0 if it is missing or not a valid book.
+int book_open(Book *book, const char *path) {
+    memset(book, 0, sizeof(*book));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(BookHeader))
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+
+    const BookHeader *header = map;
+    size_t size = st.st_size;
+    if (memcmp(header->magic, BOOK_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != BOOK_VERSION || header->entry_size != sizeof(BookEntry) ||
+        header->count > (size - sizeof(BookHeader)) / sizeof(BookEntry)) {
+        munmap(map, size);
+        return 0;
+    }
+
+    book->header = header;
+    book->entries = (const BookEntry *)(header + 1);
+    book->count = header->count;
+    book->map = map;
+    book->map_size = size;
+    return 1;
+}
+
+void book_close(Book *book) {
+    if (book->map != NULL) munmap(book->map, book->map_size);
+    memset(book, 0, sizeof(*book));
+}
+
+// Find state in the book. On a hit, fills entry with the move mapped back
+// into state's own orientation and returns 1.
+int book_lookup(const Book *book, const GameState *state, BookEntry *entry) {
+    if (book == NULL || book->count == 0) return 0;
+
+    GameState canonical;
+    int sym = book_canonical(state, &canonical);
+    size_t lo = 0, hi = book->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (book->entries[mid].key < canonical.hash) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == book->count || book->entries[lo].key != canonical.hash) return 0;
+
+    *entry = book->entries[lo];
+    entry->move = book_untransform_square(entry->move, sym);
+    return 1;
+}
\ No newline at end of file
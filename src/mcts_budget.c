@@ -0,0 +1,88 @@
+#include <math.h>
+#include <omp.h>
+
+#include "mcts_budget.h"
+
+void budget_start(SearchBudget *budget, const SearchLimits *limits) {
+    budget->limits = *limits;
+    budget->start = omp_get_wtime();
+    budget->deadline = limits->seconds > 0.0 ? budget->start + limits->seconds : INFINITY;
+    budget->next_check = EARLY_STOP_INTERVAL;
+    budget->stopped = limits->iterations <= 0 && limits->seconds <= 0.0 && limits->cancel == NULL;
+}
+
+// Deadline and cancellation check only, for searches that cannot see the
+// shared root. Whoever notices first raises stopped for everyone else.
+int budget_expired(SearchBudget *budget) {
+    if (__atomic_load_n(&budget->stopped, __ATOMIC_RELAXED)) return 1;
+    const int *cancel = budget->limits.cancel;
+    if (cancel == NULL || !__atomic_load_n(cancel, __ATOMIC_RELAXED)) {
+        if (budget->deadline == INFINITY || omp_get_wtime() < budget->deadline) return 0;
+    }
+    __atomic_store_n(&budget->stopped, 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+// Playouts the search can still expect to run: what is left of the cap,
+// or of the deadline at the rate seen so far, whichever is smaller
+static double budget_remaining(const SearchBudget *budget, int done) {
+    double remaining = INFINITY;
+    if (budget->limits.iterations > 0)
+        remaining = budget->limits.iterations - done;
+    if (budget->deadline != INFINITY) {
+        double now = omp_get_wtime();
+        double elapsed = now - budget->start;
+        if (elapsed > 0.0 && done > 0) {
+            double by_time = done / elapsed * (budget->deadline - now);
+            if (by_time < remaining) remaining = by_time;
+        }
+    }
+    return remaining;
+}
+
+// Decide whether a search that has run done playouts from root should stop.
+// A solved root always stops it: further playouts would cost nothing, learn
+// nothing and only inflate the playout count.
+int budget_done(SearchBudget *budget, const Node *root, int done) {
+    if (budget->limits.iterations > 0 && done >= budget->limits.iterations) return 1;
+    if (budget_expired(budget)) return 1;
+    if (node_proven(root) != PROVEN_NONE) return 1;
+    if (!budget->limits.early_stop) return 0;
+
+    // The root is scanned every EARLY_STOP_INTERVAL playouts, and at once
+    // so that a forced move costs nothing
+    int next = __atomic_load_n(&budget->next_check, __ATOMIC_RELAXED);
+    if (done != 0 && done < next) return 0;
+    __atomic_store_n(&budget->next_check, done + EARLY_STOP_INTERVAL, __ATOMIC_RELAXED);
+    if (!root_decision_settled(root, budget_remaining(budget, done))) return 0;
+
+    __atomic_store_n(&budget->stopped, 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+// True when more search cannot change the move played from root: it is
+// solved, only one child is not a proven loss, a child is a proven win, or
+// the runner-up trails the most-visited child by more than remaining visits
+int root_decision_settled(const Node *root, double remaining) {
+    if (__atomic_load_n(&root->expand_state, __ATOMIC_ACQUIRE) != NODE_EXPANDED) return 0;
+    if (node_proven(root) != PROVEN_NONE) return 1;
+
+    int candidates = 0;
+    int first = 0, second = 0;
+    for (int i = 0; i < root->num_children; i++) {
+        const Node *child = &root->children[i];
+        int proven = node_proven(child);
+        if (proven == PROVEN_WIN) return 1;
+        if (proven == PROVEN_LOSS) continue;
+
+        candidates++;
+        int visits = node_visits(child);
+        if (visits > first) {
+            second = first;
+            first = visits;
+        } else if (visits > second) {
+            second = visits;
+        }
+    }
+    return candidates <= 1 || first - second > remaining;
+}
\ No newline at end of file
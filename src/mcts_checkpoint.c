@@ -0,0 +1,175 @@
+#define _POSIX_C_SOURCE 200809L   // fstat, mmap
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mcts_checkpoint.h"
+
+// Bytes per node over all arrays
+#define CHECKPOINT_NODE_BYTES (sizeof(uint64_t) + sizeof(uint32_t) + 4)
+
+// The field arrays of a checkpoint, laid out back to back as in the file
+typedef struct {
+    uint64_t *stats;
+    uint32_t *first_child;
+    uint8_t *num_children;
+    int8_t *move;
+    uint8_t *proven;
+    uint8_t *expanded;
+} CheckpointArrays;
+
+static void checkpoint_arrays(void *base, uint32_t count, CheckpointArrays *arrays) {
+    unsigned char *p = base;
+    arrays->stats = (uint64_t *)p;
+    p += count * sizeof(uint64_t);
+    arrays->first_child = (uint32_t *)p;
+    p += count * sizeof(uint32_t);
+    arrays->num_children = p;
+    p += count;
+    arrays->move = (int8_t *)p;
+    p += count;
+    arrays->proven = p;
+    p += count;
+    arrays->expanded = p;
+}
+
+static size_t count_nodes(const Node *node) {
+    size_t count = 1;
+    for (int i = 0; i < node->num_children; i++) count += count_nodes(&node->children[i]);
+    return count;
+}
+
+// Write the tree in breadth-first order with one sequential write. No
+// search may be running on it. Returns 0 if the file cannot be written.
+int tree_save(const MCTSTree *tree, const char *path) {
+    size_t count = count_nodes(tree->root);
+    if (count > UINT32_MAX) return 0;
+    const Node **order = malloc(count * sizeof(Node *));
+    void *data = malloc(count * CHECKPOINT_NODE_BYTES);
+    if (order == NULL || data == NULL) {
+        free(order);
+        free(data);
+        return 0;
+    }
+
+    // order doubles as the queue: children are appended as their parent is
+    // written, so every node's children land next to each other
+    CheckpointArrays arrays;
+    checkpoint_arrays(data, (uint32_t)count, &arrays);
+    size_t tail = 1;
+    order[0] = tree->root;
+    for (size_t i = 0; i < count; i++) {
+        const Node *node = order[i];
+        arrays.stats[i] = node_load_stats(node);
+        arrays.first_child[i] = (uint32_t)tail;
+        arrays.num_children[i] = node->num_children;
+        arrays.move[i] = node->move;
+        arrays.proven[i] = node_proven(node);
+        arrays.expanded[i] = node->expand_state == NODE_EXPANDED;
+        for (int c = 0; c < node->num_children; c++) order[tail++] = &node->children[c];
+    }
+
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.node_count = (uint32_t)count;
+    header.root_black = tree->root->black;
+    header.root_white = tree->root->white;
+    header.root_player = node_player(tree->root);
+
+    FILE *file = fopen(path, "wb");
+    int ok = file != NULL && fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(data, CHECKPOINT_NODE_BYTES, count, file) == count;
+    if (file != NULL && fclose(file) != 0) ok = 0;
+    free(order);
+    free(data);
+    return ok;
+}
+
+// Children must follow in breadth-first order with no gaps or overlaps
+static int valid_topology(const CheckpointArrays *arrays, uint32_t count) {
+    size_t next = 1;
+    for (uint32_t i = 0; i < count; i++) {
+        if (arrays->first_child[i] != next || arrays->proven[i] > PROVEN_LOSS) return 0;
+        next += arrays->num_children[i];
+    }
+    return next == count;
+}
+
+// Replace the tree with the one saved at path. The file is mapped and the
+// nodes are built in one allocation, in the spare pool, by a single pass
+// over its arrays. Returns 0, leaving the tree as it was, if the file is
+// not a valid checkpoint or the nodes cannot be allocated.
+int tree_load(MCTSTree *tree, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(CheckpointHeader))
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+
+    const CheckpointHeader *header = map;
+    uint32_t count = header->node_count;
+    CheckpointArrays arrays;
+    checkpoint_arrays((void *)(header + 1), count, &arrays);
+    int ok = memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) == 0 &&
+             header->version == CHECKPOINT_VERSION && count > 0 &&
+             (size_t)st.st_size == sizeof(CheckpointHeader) + count * CHECKPOINT_NODE_BYTES &&
+             (header->root_player == BLACK || header->root_player == WHITE) &&
+             (header->root_black & header->root_white) == 0 &&
+             valid_topology(&arrays, count);
+    if (!ok) {
+        munmap(map, st.st_size);
+        return 0;
+    }
+
+    GameState state = {header->root_black, header->root_white, 0, (int)header->root_player};
+    state.hash = compute_hash(&state);
+    int spare = 1 - tree->live;
+    node_pool_reset(&tree->pools[spare]);
+    Node *nodes = arena_alloc(node_pool_arena(&tree->pools[spare]), count * sizeof(Node));
+    if (nodes == NULL) {
+        munmap(map, st.st_size);
+        return 0;
+    }
+
+    // Parents come before their children, so each child's board is made
+    // from a parent that is already in place
+    init_node(&nodes[0], &state, -1, NULL);
+    for (uint32_t i = 0; ok && i < count; i++) {
+        Node *node = &nodes[i];
+        node->stats = arrays.stats[i];
+        node->proven = arrays.proven[i];
+        node->expand_state = arrays.expanded[i] ? NODE_EXPANDED : NODE_UNEXPANDED;
+        node->num_children = arrays.num_children[i];
+        node->children = node->num_children > 0 ? &nodes[arrays.first_child[i]] : NULL;
+
+        GameState parent = node_state(node);
+        uint64_t legal = get_legal_moves(&parent);
+        for (int c = 0; ok && c < node->num_children; c++) {
+            int move = arrays.move[arrays.first_child[i] + c];
+            ok = move >= 0 && move < SIZE * SIZE && (legal & SQUARE_BIT(move));
+            if (!ok) break;
+            GameState child = parent;
+            make_move_square(&child, move);
+            init_node(&node->children[c], &child, move, node);
+        }
+    }
+    munmap(map, st.st_size);
+
+    if (!ok) {
+        node_pool_reset(&tree->pools[spare]);
+        return 0;
+    }
+    node_pool_reset(&tree->pools[tree->live]);
+    tree->live = spare;
+    tree->root = &nodes[0];
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include <omp.h>
+
+#include "mcts_config.h"
+#include "mcts_tt.h"
+
+void mcts_config_default(MCTSConfig *config) {
+    config->threads = 0;
+    config->ucb_constant = UCB_CONSTANT;
+    config->rollouts = ROLLOUTS;
+    config->virtual_loss = VIRTUAL_LOSS;
+    config->max_path_len = MAX_PATH_LEN;
+    config->endgame_empties = ENDGAME_EMPTIES;
+    config->root_merge_depth = ROOT_MERGE_DEPTH;
+    config->root_sync_interval = ROOT_SYNC_INTERVAL;
+    config->root_sync_depth = ROOT_SYNC_DEPTH;
+    config->probe_interval = PROBE_INTERVAL;
+    config->tt_bytes = TT_DEFAULT_BYTES;
+    config->mode = 0;
+    config->seed = 0;
+}
+
+static int clamp_int(int value, int lo, int hi) {
+    return value < lo ? lo : (value > hi ? hi : value);
+}
+
+// Pull every setting into the range the search code supports
+void mcts_config_clamp(MCTSConfig *config) {
+    if (config->threads <= 0) config->threads = omp_get_max_threads();
+    if (!(config->ucb_constant >= 0.0)) config->ucb_constant = UCB_CONSTANT;
+    config->rollouts = clamp_int(config->rollouts, 1, 1 << 20);
+    config->virtual_loss = clamp_int(config->virtual_loss, 0, 1 << 10);
+    config->max_path_len = clamp_int(config->max_path_len, 2, MAX_PATH_LEN);
+    config->endgame_empties = clamp_int(config->endgame_empties, 0, 60);
+    config->root_merge_depth = clamp_int(config->root_merge_depth, 1, 64);
+    config->root_sync_interval = clamp_int(config->root_sync_interval, 1, 1 << 20);
+    config->root_sync_depth = clamp_int(config->root_sync_depth, 1, 2);
+    config->probe_interval = clamp_int(config->probe_interval, 0, 1 << 20);
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include <omp.h>
+#include <string.h>
+
+#include "mcts_engine.h"
+
+// The engine's transposition table, or NULL when it was configured without one
+static TranspositionTable* engine_tt(MCTSEngine *engine) {
+    return engine->tt.entries != NULL ? &engine->tt : NULL;
+}
+
+// Set up an engine with config (clamped to supported ranges). tasks may be
+// a pool shared with other engines, or NULL for one of config->threads
+// workers owned by this engine. Returns 0 on allocation failure.
+int mcts_engine_init(MCTSEngine *engine, const MCTSConfig *config, TaskPool *tasks) {
+    memset(engine, 0, sizeof(*engine));
+    engine->config = *config;
+    mcts_config_clamp(&engine->config);
+
+    if (engine->config.tt_bytes > 0 && !tt_init(&engine->tt, engine->config.tt_bytes)) return 0;
+    if (tasks == NULL) {
+        task_pool_init(&engine->own_tasks, engine->config.threads);
+        tasks = &engine->own_tasks;
+    }
+    engine->tasks = tasks;
+
+    GameState start;
+    init_board(&start);
+    tree_init(&engine->tree, &start);
+    rng_seed(&engine->rng, engine->config.seed);
+    ponder_init(&engine->ponder, &engine->tree, engine->tasks, engine_tt(engine),
+                &engine->config, rng_next(&engine->rng));
+    return 1;
+}
+
+void mcts_engine_destroy(MCTSEngine *engine) {
+    ponder_stop(&engine->ponder);
+    tree_destroy(&engine->tree);
+    tt_destroy(&engine->tt);
+    if (engine->tasks == &engine->own_tasks) task_pool_destroy(&engine->own_tasks);
+    engine->tasks = NULL;
+}
+
+
+// Forget everything learned and start from state
+void mcts_engine_new_game(MCTSEngine *engine, const GameState *state) {
+    ponder_stop(&engine->ponder);
+    tree_reset(&engine->tree, state);
+    if (engine_tt(engine) != NULL) tt_clear(&engine->tt);
+}
+
+// Most promising root child. Solved children outrank (or fall behind) any
+// sampled estimate, and an unvisited child still beats a proven loss, so a
+// decision settled before any playout (a forced move) has an answer.
+static Node* best_root_child(Node *root) {
+    Node *best = NULL;
+    double best_winrate = -1.0;
+    for (int i = 0; i < root->num_children; i++) {
+        Node *child = &root->children[i];
+        uint64_t stats = node_load_stats(child);
+        double winrate = child->proven == PROVEN_WIN  ? 2.0 :
+                         child->proven == PROVEN_LOSS ? -0.5 :
+                         stats_visits(stats) == 0     ? -0.25 :
+                         stats_wins(stats) / stats_visits(stats);
+        if (winrate > best_winrate) {
+            best_winrate = winrate;
+            best = child;
+        }
+    }
+    return best;
+}
+
+// Answer from the opening book if it holds state. The move is checked
+// against the legal moves so a key collision can never play an illegal one.
+static int book_move(MCTSEngine *engine, const GameState *state, MCTSResult *out) {
+    BookEntry entry;
+    if (!book_lookup(engine->book, state, &entry) ||
+        !(get_legal_moves(state) & SQUARE_BIT(entry.move)))
+        return 0;
+
+    engine->stats.book_hits++;
+    out->move = entry.move;
+    out->visits = entry.visits;
+    out->win_rate = entry.value / 65535.0;
+    out->from_book = 1;
+    return 1;
+}
+
+// Search state within limits with the configured mode, keeping whatever
+// the tree already knows about the position. Any running ponder is stopped
+// first, and booked positions are answered without a search. Returns 0 if
+// there is no move to make.
+int mcts_engine_search(MCTSEngine *engine, const GameState *state, const SearchLimits *limits,
+                       MCTSResult *result) {
+    MCTSResult out = {-1, 0, 0.0, PROVEN_NONE, 0, 0, {0.0, 0.0, 0.0, 0.0, 0.0, 0}};
+    ponder_stop(&engine->ponder);
+    if (book_move(engine, state, &out)) {
+        if (result != NULL) *result = out;
+        return 1;
+    }
+    out.reused = tree_set_position(&engine->tree, state);
+
+    Node *root = engine->tree.root;
+    NodePool *pool = tree_pool(&engine->tree);
+    if (root->num_children == 0) {
+        expand(root, node_pool_arena(pool));
+    }
+    if (root->num_children == 0) {
+        if (result != NULL) *result = out;
+        return 0;
+    }
+
+    const MCTSConfig *config = &engine->config;
+    TranspositionTable *tt = engine_tt(engine);
+    RNG *rng = &engine->rng;
+    switch (config->mode) {
+        case MCTS_LEAF_PARALLEL:
+            out.timing = mcts_leaf_parallel(root, pool, engine->tasks, config, limits, rng);
+            break;
+        case MCTS_ROOT_PARALLEL:
+            out.timing = mcts_root_parallel(root, pool, engine->tasks, config, limits, rng);
+            break;
+        case MCTS_ROOT_PARALLEL_VIRTUAL_LOSS:
+            out.timing = mcts_root_parallel_virtual_loss(root, pool, engine->tasks, tt, config, limits, rng);
+            break;
+        case MCTS_ROOT_PARALLEL_SYNC:
+            out.timing = mcts_root_parallel_sync(root, pool, engine->tasks, config, limits, rng);
+            break;
+        case MCTS_SEQUENTIAL:
+        default:
+            out.timing = mcts_sequential(root, pool, tt, config, limits, rng);
+            break;
+    }
+
+    engine->stats.searches++;
+    engine->stats.playouts += out.timing.iterations;
+    engine->stats.search_time += out.timing.total;
+
+    Node *best = best_root_child(root);
+    if (best != NULL) {
+        uint64_t stats = node_load_stats(best);
+        out.move = best->move;
+        out.visits = stats_visits(stats);
+        out.win_rate = out.visits > 0 ? stats_wins(stats) / out.visits : 0.0;
+        out.proven = node_proven(best);
+    }
+    if (result != NULL) *result = out;
+    return best != NULL;
+}
+
+// Checkpoint the engine's tree to path, stopping any ponder first
+int mcts_engine_save(MCTSEngine *engine, const char *path) {
+    ponder_stop(&engine->ponder);
+    return tree_save(&engine->tree, path);
+}
+
+// Warm-start from a tree saved by mcts_engine_save. The next search reuses
+// it if its position is the saved root or within two plies of it.
+int mcts_engine_load(MCTSEngine *engine, const char *path) {
+    ponder_stop(&engine->ponder);
+    if (!tree_load(&engine->tree, path)) return 0;
+    if (engine_tt(engine) != NULL) tt_clear(&engine->tt);
+    return 1;
+}
+
+// Play book moves, when state is booked, instead of searching. The book
+// must stay open while the engine uses it; NULL turns the book off.
+void mcts_engine_set_book(MCTSEngine *engine, const Book *book) {
+    engine->book = book;
+}
+
+// Search state (normally the position after our move) in the background
+// until the next mcts_engine_search, mcts_engine_stop or the limits
+int mcts_engine_ponder(MCTSEngine *engine, const GameState *state, const SearchLimits *limits) {
+    return ponder_start(&engine->ponder, state, limits);
+}
+
+// Cancel pondering; returns the playouts it ran
+int mcts_engine_stop(MCTSEngine *engine) {
+    return ponder_stop(&engine->ponder);
+}
+
+void mcts_engine_get_stats(const MCTSEngine *engine, MCTSEngineStats *stats) {
+    *stats = engine->stats;
+    stats->tree_bytes = tree_bytes_used(&engine->tree);
+}
\ No newline at end of file
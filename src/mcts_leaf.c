@@ -2,88 +2,159 @@
 #include <stdint.h>
 #include "mcts_leaf.h"
 
+// One group of rollouts from a single leaf, shared by the pool tasks
+typedef struct {
+    const GameState *states;
+    double *results;
+    int count;
+    int num_tasks;
+    uint64_t seed_base;
+    double *wins;           // Per task: summed results of its share
+    uint64_t *sim_ticks;    // Per task: cycles spent, when sampled
+    int sampled;
+} LeafGroup;
 
-MCTSTiming mcts_leaf_parallel(Node *root, int iterations) {
-    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0};
-    
-    if (root == NULL) return timing;
-    
-    double total_start = omp_get_wtime();
-    
-    int groups = iterations / ROLLOUTS;
-    if (groups == 0) groups = 1;
+// Each task plays its share of the rollouts as one lockstep batch and
+// reduces them to a single win total; nothing in the tree is touched here
+static void leaf_rollout_task(void *arg, int index, int worker) {
+    (void)worker;
+    LeafGroup *group = arg;
+    int lo = group->count * index / group->num_tasks;
+    int hi = group->count * (index + 1) / group->num_tasks;
+    RNG thread_rng;
+    rng_seed_stream(&thread_rng, group->seed_base, (uint64_t)index);
+
+    // Simulation
+    uint64_t start = PROBES_ENABLED && group->sampled ? probe_ticks() : 0;
+    simulate_batch(group->states + lo, hi - lo, group->results + lo, &thread_rng);
+    double wins = 0.0;
+    for (int r = lo; r < hi; r++)
+        wins += group->results[r];
+    group->wins[index] = wins;
+    if (PROBES_ENABLED && group->sampled) group->sim_ticks[index] = probe_ticks() - start;
+}
 
-    for (int g = 0; g < groups; g++) {
+// State of one leaf-parallel search
+typedef struct {
+    Node *root;
+    NodeArena *arena;
+    TaskPool *tasks;
+    const MCTSConfig *config;
+    SearchBudget *budget;
+    RNG *rng;
+    int batch_size;
+    int num_tasks;
+    GameState *batch_states;
+    double *results;
+    double *task_wins;
+    uint64_t *sim_ticks;
+} LeafSearch;
+
+// Leaf-parallel search loop, expanded once with probes and once without.
+// A sample covers one whole group; rollout cycles are summed over the
+// tasks that ran it. Returns the groups run.
+PROBE_INLINE int leaf_loop(LeafSearch *search, PhaseProbe *probe, const int instrumented) {
+    Node *root = search->root;
+    const MCTSConfig *config = search->config;
+    RNG *rng = search->rng;
+    int batch_size = search->batch_size;
+    int groups;
+    for (groups = 0; !budget_done(search->budget, root, groups * batch_size); groups++) {
+        int sampled = PROBE_SAMPLE(instrumented, config->probe_interval, groups);
+        uint64_t mark = sampled ? probe_ticks() : 0;
         Node *node = root;
 
         // Selection
-        double sel_start = omp_get_wtime();
-        while (node->num_children > 0) {
-            node = select_child(node);
+        while (node->num_children > 0 && node_proven(node) == PROVEN_NONE) {
+            node = select_child(node, NULL, config);
         }
-        double sel_end = omp_get_wtime();
-        timing.selection += (sel_end - sel_start);
+        if (sampled) probe_lap(probe, PHASE_SELECTION, &mark);
 
         // Expansion
-        double exp_start = omp_get_wtime();
-        if (node->visits > 0 && has_valid_moves(&node->state)) {
-            expand(node);
+        if (node_visits(node) > 0 && node_proven(node) == PROVEN_NONE) {
+            expand(node, search->arena);
             if (node->num_children > 0) {
-                node = node->children[rand() % node->num_children];
+                node = &node->children[rng_bounded(rng, node->num_children)];
             }
         }
-        double exp_end = omp_get_wtime();
-        timing.expansion += (exp_end - exp_start);
-
-        GameState base_state = node->state;
-        int original_player = base_state.player;
-        unsigned int seed_base = (unsigned int)rand() ^ (unsigned int)time(NULL) ^ (unsigned int)(g * 0x9e3779b9u);
-        
-        double sim_time = 0.0;
-        double back_time = 0.0;
-        
-        #pragma omp parallel reduction(+:sim_time,back_time) firstprivate(base_state, original_player, seed_base)
-        {
-            #pragma omp for schedule(dynamic)
-            for (int r = 0; r < ROLLOUTS; r++) {
-                unsigned int thread_seed = seed_base ^ (unsigned int)(r * 0x9e3779b9u) ^ (unsigned int)omp_get_thread_num();
-                GameState state_copy = base_state;
-
-                // Simulation
-                double sim_start = omp_get_wtime();
-                double result = simulate(&state_copy, original_player, &thread_seed, 1);
-                double sim_end = omp_get_wtime();
-                sim_time += (sim_end - sim_start);
-                
-                // Backpropagation
-                double back_start = omp_get_wtime();
-                Node *n = node;
-                while (n != NULL) {
-                    double add;
-                    if (n->player_just_moved == original_player) {
-                        add = result;           // wins for player_just_moved
-                    } else {
-                        add = 1.0 - result;     // opponent's wins
-                    }
-
-                    #pragma omp atomic
-                    n->visits += 1;
-
-                    #pragma omp atomic
-                    n->wins += add;
-
-                    n = n->parent;
-                }
-                double back_end = omp_get_wtime();
-                back_time += (back_end - back_start);
+        if (sampled) probe_lap(probe, PHASE_EXPANSION, &mark);
+
+        // Simulation. A solved leaf needs no rollouts: the whole batch
+        // scores its exact value.
+        double wins;
+        if (solve_leaf(node, config, &wins)) {
+            wins *= batch_size;
+            if (sampled) probe_lap(probe, PHASE_SIMULATION, &mark);
+        } else {
+            GameState base_state = node_state(node);
+            for (int r = 0; r < batch_size; r++)
+                search->batch_states[r] = base_state;
+
+            LeafGroup group = {search->batch_states, search->results, batch_size, search->num_tasks,
+                               rng_next(rng), search->task_wins, search->sim_ticks, sampled};
+            task_pool_run(search->tasks, leaf_rollout_task, &group, search->num_tasks);
+
+            wins = 0.0;
+            for (int t = 0; t < search->num_tasks; t++)
+                wins += search->task_wins[t];
+            if (sampled) {
+                for (int t = 0; t < search->num_tasks; t++)
+                    probe->ticks[PHASE_SIMULATION] += search->sim_ticks[t];
+                mark = probe_ticks();
             }
-        }        
-        timing.simulation += sim_time;
-        timing.backpropagation += back_time;
+        }
+
+        // Backpropagation: one combined update per node on the path
+        backpropagate_batch(node, batch_size, wins);
+        if (sampled) {
+            probe_lap(probe, PHASE_BACKPROPAGATION, &mark);
+            probe->samples++;
+        }
+    }
+    return groups;
+}
+
+// Leaf parallelism: each selected leaf gets config->rollouts rollouts spread
+// over the pool, and the combined result climbs the path once. Limits count
+// playouts and are checked between groups. If the batch buffers cannot be
+// allocated nothing runs and the timings are zero.
+MCTSTiming mcts_leaf_parallel(Node *root, NodePool *pool, TaskPool *tasks, const MCTSConfig *config,
+                              const SearchLimits *limits, RNG *rng) {
+    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0, 0};
+    
+    if (root == NULL) return timing;
+    int batch_size = config->rollouts < 1 ? 1 : config->rollouts;
+
+    // Expansion is serial, so the whole tree grows in this thread's arena
+    int num_tasks = task_pool_size(tasks);
+    if (num_tasks > batch_size) num_tasks = batch_size;
+
+    SearchBudget budget;
+    budget_start(&budget, limits);
+    LeafSearch search = {root, node_pool_arena(pool), tasks, config, &budget, rng, batch_size, num_tasks,
+                         malloc(batch_size * sizeof(GameState)), malloc(batch_size * sizeof(double)),
+                         malloc(num_tasks * sizeof(double)), malloc(num_tasks * sizeof(uint64_t))};
+    if (search.batch_states == NULL || search.results == NULL ||
+        search.task_wins == NULL || search.sim_ticks == NULL) {
+        free(search.batch_states);
+        free(search.results);
+        free(search.task_wins);
+        free(search.sim_ticks);
+        return timing;
     }
+
+    PhaseProbe probe;
+    probe_start(&probe);
+    int groups = PROBE_DISPATCH(config, leaf_loop(&search, &probe, 1), leaf_loop(&search, &probe, 0));
+    probe_finish(&probe, groups, &timing);
+
+    free(search.batch_states);
+    free(search.results);
+    free(search.task_wins);
+    free(search.sim_ticks);
     
-    double total_end = omp_get_wtime();
-    timing.total = total_end - total_start;
+    timing.total = omp_get_wtime() - probe.start_time;
+    timing.iterations = groups * batch_size;
     
     return timing;
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "mcts_ponder.h"
+
+void ponder_init(Ponderer *ponder, MCTSTree *tree, TaskPool *tasks, TranspositionTable *tt,
+                 const MCTSConfig *config, uint64_t seed) {
+    ponder->tree = tree;
+    ponder->tasks = tasks;
+    ponder->tt = tt;
+    ponder->config = config;
+    rng_seed(&ponder->rng, seed);
+    ponder->cancel = 0;
+    ponder->active = 0;
+    ponder->timing = (MCTSTiming){0.0, 0.0, 0.0, 0.0, 0.0, 0};
+}
+
+// Tree-parallel search grows the shared tree in place, so whatever it has
+// done when it is cancelled is already in the tree
+static void* ponder_thread(void *arg) {
+    Ponderer *ponder = arg;
+    MCTSTree *tree = ponder->tree;
+    ponder->timing = mcts_root_parallel_virtual_loss(tree->root, tree_pool(tree), ponder->tasks, ponder->tt,
+                                                     ponder->config, &ponder->limits, &ponder->rng);
+    return NULL;
+}
+
+// Move the tree to state (normally the position after our own move) and
+// search it in the background until ponder_stop, ponder_finish or the
+// limits end it. The limits' cancel flag is replaced by the ponderer's own.
+// Returns 0 without starting if the side to move has no moves.
+int ponder_start(Ponderer *ponder, const GameState *state, const SearchLimits *limits) {
+    ponder_stop(ponder);
+
+    MoveList moves;
+    if (generate_moves(state, &moves) == 0) return 0;
+
+    MCTSTree *tree = ponder->tree;
+    tree_set_position(tree, state);
+    if (tree->root->num_children == 0)
+        expand(tree->root, node_pool_arena(tree_pool(tree)));
+
+    ponder->limits = *limits;
+    ponder->limits.cancel = &ponder->cancel;
+    __atomic_store_n(&ponder->cancel, 0, __ATOMIC_RELAXED);
+    if (pthread_create(&ponder->thread, NULL, ponder_thread, ponder) != 0) return 0;
+    ponder->active = 1;
+    return 1;
+}
+
+// Cancel a running ponder and wait for it. Workers notice the flag between
+// iterations, so this costs about one playout. Returns the playouts the
+// ponder ran, or 0 if none was running.
+int ponder_stop(Ponderer *ponder) {
+    if (!ponder->active) return 0;
+    __atomic_store_n(&ponder->cancel, 1, __ATOMIC_RELAXED);
+    pthread_join(ponder->thread, NULL);
+    ponder->active = 0;
+    return ponder->timing.iterations;
+}
+
+// Hand off to our own search once the opponent has moved to state: stop
+// pondering and re-root the tree on the matching subtree. Returns the
+// visits carried over, as tree_set_position does.
+int ponder_finish(Ponderer *ponder, const GameState *state) {
+    ponder_stop(ponder);
+    return tree_set_position(ponder->tree, state);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include <string.h>
+
+#include "mcts_probe.h"
+
+void probe_start(PhaseProbe *probe) {
+    memset(probe, 0, sizeof(*probe));
+    probe->start_time = omp_get_wtime();
+    probe->start_ticks = probe_ticks();
+}
+
+// Fill timing's phase times with the probe's samples, scaled from the
+// sampled iterations to all iterations. The counter rate is measured over
+// the probe's own lifetime, so no calibration run is needed.
+void probe_finish(const PhaseProbe *probe, int iterations, MCTSTiming *timing) {
+    double elapsed = omp_get_wtime() - probe->start_time;
+    uint64_t ticks = probe_ticks() - probe->start_ticks;
+    double seconds_per_tick = ticks > 0 ? elapsed / ticks : 0.0;
+    double scale = probe->samples > 0 ? (double)iterations / probe->samples : 0.0;
+
+    double phase[NUM_PHASES];
+    for (int p = 0; p < NUM_PHASES; p++)
+        phase[p] = probe->ticks[p] * seconds_per_tick * scale;
+    timing->selection = phase[PHASE_SELECTION];
+    timing->expansion = phase[PHASE_EXPANSION];
+    timing->simulation = phase[PHASE_SIMULATION];
+    timing->backpropagation = phase[PHASE_BACKPROPAGATION];
+}
\ No newline at end of file
@@ -1,337 +1,607 @@
 #include <omp.h>
 #include <stdint.h>
+#include <limits.h>
 #include "mcts_root.h"
+#include "mcts_tree.h"
 
-static inline double atomic_load_int(volatile int *p) {
-    int v;
-    #pragma omp atomic read
-    v = *p;
-    return (double) v;
-}
+#define EXPAND_RETRIES 2   // Fresh selections tried after losing an expansion race
 
-static inline double atomic_load_double(volatile double *p) {
-    double v;
-    #pragma omp atomic read
-    v = *p;
-    return v;
+// MCTS selection phase for trees other threads are updating. Child
+// statistics are read with relaxed atomic loads inside ucb_select.
+int select_child_index_parallel(Node *parent, TranspositionTable *tt, double ucb_constant) {
+    int best_idx = ucb_select(parent, tt, ucb_constant);
+    return best_idx < 0 ? 0 : best_idx;
 }
 
-// Atomic version of UCB1 selection logic
-double ucb1_atomic(Node *child, Node *parent) {
-    double child_visits    = atomic_load_int(&child->visits);
-    double child_wins      = atomic_load_double(&child->wins);
-    double parent_visits   = atomic_load_int(&parent->visits);
-
-    if (child_visits == 0) return INFINITY;
-    if (parent_visits == 0) parent_visits = 1; // prevent log(0)
+// MCTS expansion phase with node children array allocated locally. The
+// caller must own the node (have moved it to NODE_EXPANDING); the children
+// become visible to other threads with the release store at the end.
+void expand_parallel(Node *node, NodeArena *arena) {
+    GameState state = node_state(node);
+    MoveList moves;
+    if (generate_moves(&state, &moves) == 0) {
+        __atomic_store_n(&node->expand_state, NODE_EXPANDED, __ATOMIC_RELEASE);
+        return;
+    }
 
+    Node *new_children = arena_alloc(arena, moves.count * sizeof(Node));
+    for (int i = 0; i < moves.count; i++) {
+        int sq = moves.squares[i];
+        GameState new_state = state;
+        make_move_square(&new_state, sq);
+        init_node(&new_children[i], &new_state, sq, node);
+    }
 
-    double exploitation = child_wins / child_visits;
-    double exploration  = UCB_CONSTANT *
-                          sqrt(log(parent_visits) / child_visits);
+    node->children = new_children;
+    node->num_children = (unsigned char)moves.count;
+    __atomic_store_n(&node->expand_state, NODE_EXPANDED, __ATOMIC_RELEASE);
+}
 
-    return exploitation + exploration;
+// Claim an unexpanded node for expansion; fails if another thread got there
+// first or the node already has its children
+static inline int try_claim_expansion(Node *node) {
+    unsigned char expected = NODE_UNEXPANDED;
+    return __atomic_compare_exchange_n(&node->expand_state, &expected, NODE_EXPANDING,
+                                       0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
 }
 
-// MCTS selection phase using atomic UCB1
-int select_child_index_parallel(Node *parent) {
-    int nc = parent->num_children;
-    Node **kids = parent->children;
+// Expansion, simulation and backpropagation from a selected leaf, closing
+// a sampled iteration's probe laps
+PROBE_INLINE void complete_iteration(Node *node, NodeArena *arena, const MCTSConfig *config, RNG *rng,
+                                     PhaseProbe *probe, int sampled, uint64_t *mark) {
+    // Expansion
+    if (node_visits(node) > 0 && node_proven(node) == PROVEN_NONE) {
+        expand(node, arena);
+        if (node->num_children > 0) {
+            node = &node->children[rng_bounded(rng, node->num_children)];
+        }
+    }
+    if (sampled) probe_lap(probe, PHASE_EXPANSION, mark);
 
-    double best = -INFINITY;
-    int best_idx = 0;
+    // Simulation
+    double result = evaluate_leaf(node, config, rng);
+    if (sampled) probe_lap(probe, PHASE_SIMULATION, mark);
 
-    for (int i = 0; i < nc; i++) {
-        Node *c = kids[i];
-        if (c == NULL) continue;
-        double u = ucb1_atomic(c, parent);
-        if (u > best) { best = u; best_idx = i; }
+    // Backpropagation
+    backpropagate(node, result, NULL);
+    if (sampled) {
+        probe_lap(probe, PHASE_BACKPROPAGATION, mark);
+        probe->samples++;
     }
+}
 
-    return best_idx;
+// Child of parent reached by the same move as like, or NULL. expand()
+// generates children in a fixed order, so the same index almost always hits.
+static Node* matching_child(Node *parent, const Node *like, int hint) {
+    if (hint < parent->num_children && parent->children[hint].move == like->move)
+        return &parent->children[hint];
+    for (int i = 0; i < parent->num_children; i++)
+        if (parent->children[i].move == like->move) return &parent->children[i];
+    return NULL;
 }
 
-// MCTS expansion phase with node children array allocated locally
-void expand_parallel(Node *node) {
-    GameState *state = &node->state;
+// Add src's statistics to dst and, for depth more levels, those of its
+// descendants, expanding dst wherever src went deeper. Threads prove
+// different siblings, so each merged node is re-settled from its children.
+static void merge_subtree(Node *dst, const Node *src, int depth, NodeArena *arena) {
+    dst->stats += src->stats;
+    if (src->proven != PROVEN_NONE) dst->proven = src->proven;
+    if (depth <= 0 || src->num_children == 0) return;
+
+    if (dst->num_children == 0) expand(dst, arena);
+    for (int i = 0; i < dst->num_children; i++) {
+        Node *from = matching_child((Node *)src, &dst->children[i], i);
+        if (from != NULL)
+            merge_subtree(&dst->children[i], from, depth - 1, arena);
+    }
+    settle_proof(dst);
+}
 
-    int count = 0;
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            if (is_valid_move(state, i, j))
-                count++;
+// Fold every thread tree into the shared one. The root level is merged
+// here; below it each root child is an independent subtree, so pool tasks
+// take whole subtrees and grow the shared tree in their workers' arenas.
+typedef struct {
+    Node *root;
+    NodePool *pool;
+    Node **thread_roots;
+    int num_threads;
+    int depth;
+} MergeJob;
+
+static void merge_task(void *arg, int index, int worker) {
+    MergeJob *job = arg;
+    Node *dst = &job->root->children[index];
+    NodeArena *arena = node_pool_arena_at(job->pool, worker);
+    for (int t = 0; t < job->num_threads; t++) {
+        Node *src = matching_child(job->thread_roots[t], dst, index);
+        if (src != NULL)
+            merge_subtree(dst, src, job->depth - 1, arena);
+    }
+}
 
-    if (count == 0) return;
+static void merge_thread_trees(Node *root, NodePool *pool, TaskPool *tasks,
+                               Node **thread_roots, int num_threads, int depth) {
+    int parallel = node_pool_reserve(pool, task_pool_size(tasks));
+    NodeArena *arena = node_pool_arena(pool);
+    for (int t = 0; t < num_threads; t++) {
+        merge_subtree(root, thread_roots[t], 0, arena);
+        // A fresh shared root gets its children here, or there would be no
+        // subtrees to merge into
+        if (thread_roots[t]->num_children > 0 && root->num_children == 0) expand(root, arena);
+    }
 
-    Node **new_children = malloc(count * sizeof(Node*));
-    int idx = 0;
+    // Without an arena per worker the subtrees are merged on this thread
+    MergeJob job = {root, pool, thread_roots, num_threads, depth};
+    if (parallel) task_pool_run(tasks, merge_task, &job, root->num_children);
+    else {
+        for (int i = 0; i < root->num_children; i++)
+            merge_task(&job, i, 0);
+    }
+    settle_proof(root);
+}
 
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            if (is_valid_move(state, i, j)) {
-                GameState new_state = *state;
-                make_move(&new_state, i, j);
-                new_children[idx++] = create_node(&new_state, i, j, node);
-            }
+// One root-parallel search: task i owns private tree thread_roots[i]
+typedef struct {
+    Node *root;
+    NodePool *scratch;
+    Node **thread_roots;
+    int iters_per_thread;   // INT_MAX when only the deadline bounds the search
+    int extra_iterations;   // The first this many threads run one more
+    SearchBudget *budget;
+    const MCTSConfig *config;
+    uint64_t seed_base;
+    uint64_t *shared;       // Synchronized variant only
+    MCTSTiming *timings;
+} RootSearch;
+
+// Playout cap of thread index; the remainder of the even split goes to the
+// lowest indices so a cap below the thread count still runs
+static int thread_iterations(const RootSearch *search, int index) {
+    return search->iters_per_thread + (index < search->extra_iterations);
+}
 
-    node->children = new_children;
-    node->num_children = count;
+// A root-parallel thread's loop over its private tree, expanded once with
+// probes and once without. Stops once that tree's root is solved. Returns
+// the iterations run.
+PROBE_INLINE int root_search_loop(RootSearch *search, Node *thread_root, NodeArena *arena, RNG *rng,
+                                  int max_iterations, PhaseProbe *probe, const int instrumented) {
+    const MCTSConfig *config = search->config;
+    int i;
+    for (i = 0; i < max_iterations && node_proven(thread_root) == PROVEN_NONE &&
+                !budget_expired(search->budget); i++) {
+        int sampled = PROBE_SAMPLE(instrumented, config->probe_interval, i);
+        uint64_t mark = sampled ? probe_ticks() : 0;
+        Node *node = thread_root;
+
+        // Selection
+        while (node->num_children > 0 && node_proven(node) == PROVEN_NONE) {
+            node = select_child(node, NULL, config);
+        }
+        if (sampled) probe_lap(probe, PHASE_SELECTION, &mark);
+
+        complete_iteration(node, arena, config, rng, probe, sampled, &mark);
+    }
+    return i;
 }
 
-// Single MCTS iteration
-MCTSTiming mcts_iteration(Node *root, unsigned int *seed) {
-    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0};
-    Node *node = root;
+// Take back the statistics a thread tree was seeded with, so only what the
+// thread's own search added is merged into the shared tree
+static void unseed_subtree(Node *node, const Node *seed, int depth) {
+    node->stats -= seed->stats;
+    if (depth <= 0) return;
+    for (int i = 0; i < seed->num_children && i < node->num_children; i++)
+        unseed_subtree(&node->children[i], &seed->children[i], depth - 1);
+}
+
+static void root_search_task(void *arg, int index, int worker) {
+    RootSearch *search = arg;
+    RNG thread_rng;
+    rng_seed_stream(&thread_rng, search->seed_base, (uint64_t)index);
+
+    // Each thread starts from a copy of the shared tree as deep as the merge
+    // writes back, and then works independently
+    NodeArena *arena = node_pool_arena_at(search->scratch, worker);
+    int seed_depth = search->config->root_merge_depth;
+    Node *thread_root = tree_copy(arena, search->root, seed_depth);
+    search->thread_roots[index] = thread_root;
+
+    // Run MCTS iterations on thread-local tree
+    PhaseProbe probe;
+    probe_start(&probe);
+    int max_iterations = thread_iterations(search, index);
+    int iterations = PROBE_DISPATCH(search->config,
+        root_search_loop(search, thread_root, arena, &thread_rng, max_iterations, &probe, 1),
+        root_search_loop(search, thread_root, arena, &thread_rng, max_iterations, &probe, 0));
+    probe_finish(&probe, iterations, &search->timings[index]);
+    search->timings[index].iterations = iterations;
+    unseed_subtree(thread_root, search->root, seed_depth);
+}
 
-    // Selection
-    double sel_start = omp_get_wtime();
-    while (node->num_children > 0) {
-        node = select_child(node);
+// Start a root-parallel search with one task per pool worker, then merge the
+// private trees and return the summed phase timings. The private trees do
+// not feed the shared root until the merge, so the only early stop is for
+// a root that is settled before the search begins. If the per-thread
+// bookkeeping cannot be allocated nothing runs and the timings are zero.
+static MCTSTiming run_root_search(Node *root, NodePool *pool, TaskPool *tasks,
+                                  const MCTSConfig *config, const SearchLimits *limits,
+                                  RNG *rng, TaskFn search_task, uint64_t *shared) {
+    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0, 0};
+    int num_threads = task_pool_size(tasks);
+    if (limits->early_stop && root_decision_settled(root, INFINITY)) return timing;
+
+    SearchBudget budget;
+    budget_start(&budget, limits);
+    int iters_per_thread = limits->iterations > 0 ? limits->iterations / num_threads : INT_MAX;
+    int extra_iterations = limits->iterations > 0 ? limits->iterations % num_threads : 0;
+
+    // Thread-local trees each grow in a scratch arena that is dropped in
+    // one go after the merge
+    NodePool scratch;
+    RootSearch search = {root, &scratch, malloc(num_threads * sizeof(Node*)),
+                         iters_per_thread, extra_iterations, &budget, config, rng_next(rng), shared,
+                         calloc(num_threads, sizeof(MCTSTiming))};
+    if (search.thread_roots == NULL || search.timings == NULL ||
+        !node_pool_init(&scratch, num_threads)) {
+        free(search.thread_roots);
+        free(search.timings);
+        return timing;
     }
-    double sel_end = omp_get_wtime();
-    timing.selection = sel_end - sel_start;
 
-    // Expansion
-    double exp_start = omp_get_wtime();
-    if (node->visits > 0 && has_valid_moves(&node->state)) {
-        expand(node);
-        if (node->num_children > 0) {
-            node = node->children[rand_r(seed) % node->num_children];
-        }
+    task_pool_run(tasks, search_task, &search, num_threads);
+
+    // Aggregate timing across all threads
+    for (int t = 0; t < num_threads; t++) {
+        timing.selection += search.timings[t].selection;
+        timing.expansion += search.timings[t].expansion;
+        timing.simulation += search.timings[t].simulation;
+        timing.backpropagation += search.timings[t].backpropagation;
+        timing.iterations += search.timings[t].iterations;
     }
-    double exp_end = omp_get_wtime();
-    timing.expansion = exp_end - exp_start;
 
-    // Simulation
-    double sim_start = omp_get_wtime();
-    double result = simulate(&node->state, node->state.player, seed, 1);
-    double sim_end = omp_get_wtime();
-    timing.simulation = sim_end - sim_start;
+    merge_thread_trees(root, pool, tasks, search.thread_roots, num_threads, config->root_merge_depth);
 
-    // Backpropagation
-    double back_start = omp_get_wtime();
-    backpropagate(node, result);
-    double back_end = omp_get_wtime();
-    timing.backpropagation = back_end - back_start;
-    
+    node_pool_destroy(&scratch);
+    free(search.thread_roots);
+    free(search.timings);
     return timing;
 }
 
-// MCTS root parallel approach
-MCTSTiming mcts_root_parallel(Node *root, int total_iterations) {
-    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0};
-    
-    if (root == NULL) return timing;
+// MCTS root parallel approach. Threads search private trees seeded with the
+// top config->root_merge_depth levels of the shared tree, and what they add
+// is merged back as deep, so the shared tree carries over between searches.
+MCTSTiming mcts_root_parallel(Node *root, NodePool *pool, TaskPool *tasks, const MCTSConfig *config,
+                              const SearchLimits *limits, RNG *rng) {
+    if (root == NULL) return (MCTSTiming){0.0, 0.0, 0.0, 0.0, 0.0, 0};
 
     double total_start = omp_get_wtime();
-
-    int num_threads = omp_get_max_threads();
-    int iters_per_thread = total_iterations / num_threads;
-
-    // Create thread-local root copies
-    Node **thread_roots = malloc(num_threads * sizeof(Node*));
+    MCTSTiming timing = run_root_search(root, pool, tasks, config, limits, rng,
+                                        root_search_task, NULL);
+    double total_end = omp_get_wtime();
+    timing.total = total_end - total_start;
     
-    // Arrays to accumulate timing from each thread
-    double *sel_times = calloc(num_threads, sizeof(double));
-    double *exp_times = calloc(num_threads, sizeof(double));
-    double *sim_times = calloc(num_threads, sizeof(double));
-    double *back_times = calloc(num_threads, sizeof(double));
-
-    #pragma omp parallel
-    {
-        int tid = omp_get_thread_num();
-        unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)tid ^ 0x9e3779b9u;
-
-        // Each thread clones the root and works independently
-        thread_roots[tid] = clone_node(root, NULL);
-
-        // Run MCTS iterations on thread-local tree
-        for (int i = 0; i < iters_per_thread; i++) {
-            MCTSTiming iter_timing = mcts_iteration(thread_roots[tid], &seed);
-            sel_times[tid] += iter_timing.selection;
-            exp_times[tid] += iter_timing.expansion;
-            sim_times[tid] += iter_timing.simulation;
-            back_times[tid] += iter_timing.backpropagation;
-        }
-    }
+    return timing;
+}
 
-    // Aggregate timing across all threads
-    for (int t = 0; t < num_threads; t++) {
-        timing.selection += sel_times[t];
-        timing.expansion += exp_times[t];
-        timing.simulation += sim_times[t];
-        timing.backpropagation += back_times[t];
-    }
+// Slots in the shared statistics table used by mcts_root_parallel_sync:
+// the root, then one per first move, then one per (first, second) move pair.
+// Nodes are keyed by square, so every thread's private tree maps onto the
+// same slots without any coordination.
+#define SYNC_SLOTS (1 + SIZE * SIZE + SIZE * SIZE * SIZE * SIZE)
 
-    if (root->num_children == 0) {
-        for (int t = 0; t < num_threads; t++) {
-            if (thread_roots[t]->num_children > 0) {
-                expand(root);
-                break;
-            }
-        }
+static inline int sync_slot(const Node *node, int depth) {
+    if (depth == 0) return 0;
+    if (depth == 1) return 1 + node->move;
+    return 1 + SIZE * SIZE + node->parent->move * SIZE * SIZE + node->move;
+}
+
+// Publish what this thread learned since its last sync and refresh its view
+// of everyone else's totals. published holds the local stats already added
+// to shared; others holds shared minus this thread's own share.
+static void sync_node(const Node *node, int depth, int max_depth, uint64_t *shared,
+                      uint64_t *published, uint64_t *others) {
+    int slot = sync_slot(node, depth);
+    uint64_t local = node->stats;
+    if (local != published[slot]) {
+        __atomic_fetch_add(&shared[slot], local - published[slot], __ATOMIC_RELAXED);
+        published[slot] = local;
     }
+    others[slot] = __atomic_load_n(&shared[slot], __ATOMIC_RELAXED) - local;
 
-    // Aggregate statistics from all thread-local roots
-    if (root->num_children > 0) {
-        for (int t = 0; t < num_threads; t++) {
-            Node *thread_root = thread_roots[t];
+    if (depth + 1 > max_depth) return;
+    for (int i = 0; i < node->num_children; i++)
+        sync_node(&node->children[i], depth + 1, max_depth, shared, published, others);
+}
 
-            // Merge child statistics
-            for (int i = 0; i < thread_root->num_children; i++) {
-                Node *thread_child = thread_root->children[i];
+// Start table off with the statistics of node and its descendants down to
+// max_depth, the totals every thread tree is seeded with
+static void sync_seed(const Node *node, int depth, int max_depth, uint64_t *table) {
+    table[sync_slot(node, depth)] = node->stats;
+    if (depth + 1 > max_depth) return;
+    for (int i = 0; i < node->num_children; i++)
+        sync_seed(&node->children[i], depth + 1, max_depth, table);
+}
 
-                for (int j = 0; j < root->num_children; j++) {
-                    Node *main_child = root->children[j];
+static int sync_depth(const MCTSConfig *config) {
+    return config->root_sync_depth > 2 ? 2 : config->root_sync_depth;
+}
 
-                    if (main_child->move_row == thread_child->move_row &&
-                        main_child->move_col == thread_child->move_col) {
-                        main_child->visits += thread_child->visits;
-                        main_child->wins += thread_child->wins;
-                        break;
-                    }
-                }
-            }
-            free_tree(thread_root);
+// UCB1 over local statistics plus the other threads' totals
+static Node* select_child_synced(Node *node, int depth, const uint64_t *others, double ucb_constant) {
+    double parent_visits = stats_visits(node->stats + others[sync_slot(node, depth)]);
+    if (parent_visits < 1) parent_visits = 1;
+
+    Node *best = NULL;
+    double best_ucb = -INFINITY;
+    for (int i = 0; i < node->num_children; i++) {
+        Node *child = &node->children[i];
+        double ucb;
+        if (child->proven == PROVEN_WIN) ucb = INFINITY;
+        else if (child->proven == PROVEN_LOSS) ucb = -INFINITY;
+        else {
+            uint64_t stats = child->stats + others[sync_slot(child, depth + 1)];
+            int visits = stats_visits(stats);
+            ucb = visits == 0 ? INFINITY
+                : stats_wins(stats) / visits + ucb_constant * sqrt(log(parent_visits) / visits);
+        }
+        if (ucb > best_ucb || best == NULL) {
+            best_ucb = ucb;
+            best = child;
         }
     }
+    return best;
+}
 
-    free(thread_roots);
-    free(sel_times);
-    free(exp_times);
-    free(sim_times);
-    free(back_times);
+// Per-thread state of a synchronized root-parallel search
+typedef struct {
+    Node *thread_root;
+    NodeArena *arena;
+    RNG *rng;
+    uint64_t *published;
+    uint64_t *others;
+    int sync_depth;
+    int max_iterations;
+} SyncThread;
+
+// A synchronized root-parallel thread's loop, expanded once with probes
+// and once without. Stops once its root is solved. Returns the iterations
+// run.
+PROBE_INLINE int root_sync_loop(RootSearch *search, SyncThread *thread, PhaseProbe *probe,
+                                const int instrumented) {
+    const MCTSConfig *config = search->config;
+    int i;
+    for (i = 0; i < thread->max_iterations && node_proven(thread->thread_root) == PROVEN_NONE &&
+                !budget_expired(search->budget); i++) {
+        if (i % config->root_sync_interval == 0)
+            sync_node(thread->thread_root, 0, thread->sync_depth, search->shared,
+                      thread->published, thread->others);
+
+        int sampled = PROBE_SAMPLE(instrumented, config->probe_interval, i);
+        uint64_t mark = sampled ? probe_ticks() : 0;
+        Node *node = thread->thread_root;
+
+        // Selection, with the synchronized levels seeing global totals
+        int depth = 0;
+        while (node->num_children > 0 && node->proven == PROVEN_NONE) {
+            node = depth < thread->sync_depth
+                 ? select_child_synced(node, depth, thread->others, config->ucb_constant)
+                 : select_child(node, NULL, config);
+            depth++;
+        }
+        if (sampled) probe_lap(probe, PHASE_SELECTION, &mark);
 
-    double total_end = omp_get_wtime();
-    timing.total = total_end - total_start;
-    
-    return timing;
+        complete_iteration(node, thread->arena, config, thread->rng, probe, sampled, &mark);
+    }
+    return i;
 }
 
-// MCTS root parallel with virtual loss approach
-MCTSTiming mcts_root_parallel_virtual_loss(Node *root, int total_iterations) {
-    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0};
-    
-    if (root == NULL || total_iterations <= 0) return timing;
-
-    double total_start = omp_get_wtime();
+static void root_sync_task(void *arg, int index, int worker) {
+    RootSearch *search = arg;
+    RNG thread_rng;
+    rng_seed_stream(&thread_rng, search->seed_base, (uint64_t)index);
+
+    // Seeded from the shared tree like root_search_task; root children are
+    // created up front so the first sync sees them. The seed counts as
+    // already published, since the shared table starts from it too.
+    NodeArena *arena = node_pool_arena_at(search->scratch, worker);
+    int seed_depth = search->config->root_merge_depth;
+    Node *thread_root = tree_copy(arena, search->root, seed_depth);
+    if (thread_root->num_children == 0) expand(thread_root, arena);
+    search->thread_roots[index] = thread_root;
+
+    SyncThread thread = {thread_root, arena, &thread_rng, calloc(SYNC_SLOTS, sizeof(uint64_t)),
+                         calloc(SYNC_SLOTS, sizeof(uint64_t)), sync_depth(search->config),
+                         thread_iterations(search, index)};
+
+    // Without its sync tables the thread sits the search out, leaving its
+    // seed to merge back as nothing new
+    if (thread.published != NULL && thread.others != NULL) {
+        sync_seed(thread_root, 0, thread.sync_depth, thread.published);
+
+        PhaseProbe probe;
+        probe_start(&probe);
+        int iterations = PROBE_DISPATCH(search->config,
+            root_sync_loop(search, &thread, &probe, 1),
+            root_sync_loop(search, &thread, &probe, 0));
+        probe_finish(&probe, iterations, &search->timings[index]);
+        search->timings[index].iterations = iterations;
+    }
+    unseed_subtree(thread_root, search->root, seed_depth);
 
-    // Track cumulative times across all threads
-    double sel_time = 0.0, exp_time = 0.0, sim_time = 0.0, back_time = 0.0;
+    free(thread.published);
+    free(thread.others);
+}
 
-    #pragma omp parallel reduction(+:sel_time,exp_time,sim_time,back_time)
-    {
-        unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)omp_get_thread_num() ^ 0x9e3779b9u;
+// MCTS root parallel with periodic synchronization. Threads still search
+// private trees, but every root_sync_interval iterations each one adds its
+// new root-level (and, with root_sync_depth 2, depth-2) statistics to a
+// shared table and reads back the other threads' totals, which its UCB
+// selection then counts as if they were its own. Threads sync on their own
+// schedule with atomic adds, so nobody waits and no private tree is locked.
+MCTSTiming mcts_root_parallel_sync(Node *root, NodePool *pool, TaskPool *tasks, const MCTSConfig *config,
+                                   const SearchLimits *limits, RNG *rng) {
+    if (root == NULL) return (MCTSTiming){0.0, 0.0, 0.0, 0.0, 0.0, 0};
 
-        #pragma omp for schedule(dynamic)
-        for (int iter = 0; iter < total_iterations; ++iter) {
-            Node *path[MAX_PATH_LEN];
-            int path_len = 0;
+    double total_start = omp_get_wtime();
+    uint64_t *shared = calloc(SYNC_SLOTS, sizeof(uint64_t));
+    if (shared == NULL) return (MCTSTiming){0.0, 0.0, 0.0, 0.0, 0.0, 0};
+    sync_seed(root, 0, sync_depth(config), shared);
+    MCTSTiming timing = run_root_search(root, pool, tasks, config, limits, rng,
+                                        root_sync_task, shared);
+    free(shared);
+    double total_end = omp_get_wtime();
+    timing.total = total_end - total_start;
 
-            Node *node = root;
+    return timing;
+}
 
-            // Selection phase
-            double sel_start = omp_get_wtime();
-            int depth = 0;
-            while (depth++ < 2000) {
-                if (path_len >= MAX_PATH_LEN) break;
-                
+// One tree-parallel search shared by all tasks
+typedef struct {
+    Node *root;
+    NodePool *pool;
+    TranspositionTable *tt;
+    const MCTSConfig *config;
+    SearchBudget *budget;
+    int next_iteration;     // Claimed with an atomic add, like a dynamic schedule
+    uint64_t seed_base;
+    MCTSTiming *timings;
+} TreeSearch;
+
+// A tree-parallel thread's loop, expanded once with probes and once
+// without. Returns the iterations this thread ran.
+PROBE_INLINE int tree_search_loop(TreeSearch *search, NodeArena *arena, RNG *rng, PhaseProbe *probe,
+                                  const int instrumented) {
+    Node *root = search->root;
+    TranspositionTable *tt = search->tt;
+    const MCTSConfig *config = search->config;
+    uint64_t virtual_loss = (uint64_t)config->virtual_loss * NODE_VISIT;
+    int max_path_len = config->max_path_len < MAX_PATH_LEN ? config->max_path_len : MAX_PATH_LEN;
+    int iterations = 0;
+
+    for (;;) {
+        int claimed = __atomic_fetch_add(&search->next_iteration, 1, __ATOMIC_RELAXED);
+        if (budget_done(search->budget, root, claimed)) break;
+        int sampled = PROBE_SAMPLE(instrumented, config->probe_interval, iterations);
+        uint64_t mark = sampled ? probe_ticks() : 0;
+        iterations++;
+
+        Node *path[MAX_PATH_LEN];
+        int path_len = 0;
+        Node *node = root;
+
+        for (int attempt = 0; ; attempt++) {
+            // Selection phase, holding a virtual loss on every node passed
+            path_len = 0;
+            node = root;
+            for (;;) {
                 path[path_len++] = node;
+                node_add_stats(node, virtual_loss);
 
-                // Apply virtual loss
-                #pragma omp atomic
-                node->visits += 1;
-                #pragma omp atomic
-                node->wins -= VIRTUAL_LOSS;
-
-                int nc;
-                Node **children;
-                
-                nc = node->num_children;
-                children = node->children;
-
-                if (nc == 0 || children == NULL) break;
-
-                int idx = select_child_index_parallel(node);
-                if (idx < 0 || idx >= nc) break;
-                
-                Node *child = children[idx];
-                if (child == NULL) break;
-                
-                node = child;
+                if (path_len >= max_path_len || node_proven(node) != PROVEN_NONE) break;
+                if (__atomic_load_n(&node->expand_state, __ATOMIC_ACQUIRE) != NODE_EXPANDED) break;
+                if (node->num_children == 0) break;
+
+                node = &node->children[select_child_index_parallel(node, tt, config->ucb_constant)];
             }
-            double sel_end = omp_get_wtime();
-            sel_time += (sel_end - sel_start);
+            if (sampled) probe_lap(probe, PHASE_SELECTION, &mark);
 
             // Expansion
-            double exp_start = omp_get_wtime();
-            if (node != NULL && has_valid_moves(&node->state)) {
-                omp_set_lock(&node->lock);
-                // Check if expansion still needed (another thread might have expanded)
-                if (node->num_children == 0 && has_valid_moves(&node->state)) {
-                    expand_parallel(node);
-                }
-                omp_unset_lock(&node->lock);
-
-                // If node gained children due to expansion, pick child
-                if (node->num_children > 0 && node->children != NULL) {
-                    int pick = rand_r(&seed) % node->num_children;
-                    Node *child = node->children[pick];
-                    
-                    if (child != NULL && path_len < MAX_PATH_LEN) {
-                        node = child;
+            int done = 1;
+            if (node_proven(node) == PROVEN_NONE && path_len < max_path_len &&
+                __atomic_load_n(&node->expand_state, __ATOMIC_RELAXED) != NODE_EXPANDED) {
+                if (try_claim_expansion(node)) {
+                    expand_parallel(node, arena);
+                    if (node->num_children > 0) {
+                        node = &node->children[rng_bounded(rng, node->num_children)];
                         path[path_len++] = node;
-
-                        #pragma omp atomic
-                        node->visits += 1;
-                        #pragma omp atomic
-                        node->wins -= VIRTUAL_LOSS;
+                        node_add_stats(node, virtual_loss);
                     }
+                } else if (attempt < EXPAND_RETRIES) {
+                    // Another thread is expanding this leaf. Rather than
+                    // wait, drop this path's virtual losses and select
+                    // again; the winner's virtual loss steers us elsewhere.
+                    for (int p = 0; p < path_len; ++p)
+                        node_add_stats(path[p], -virtual_loss);
+                    done = 0;
                 }
+                // Out of retries: evaluate the contended leaf as it is
             }
-            double exp_end = omp_get_wtime();
-            exp_time += (exp_end - exp_start);
-
-            // Simulation
-            double sim_start = omp_get_wtime();
-            double result = (node != NULL) ? 
-                simulate(&node->state, node->state.player, &seed, 1) : 0.5;
-            double sim_end = omp_get_wtime();
-            sim_time += (sim_end - sim_start);
-
-            // Backpropagation
-            double back_start = omp_get_wtime();
-            if (path_len > 0) {
-                int original_player = path[path_len - 1]->state.player;
-                
-                for (int p = 0; p < path_len; ++p) {
-                    Node *n = path[p];
-                    if (n == NULL) continue;
-
-                    double add;
-                    if (n->player_just_moved == original_player) 
-                        add = result;
-                    else 
-                        add = 1.0 - result;
-
-                    double wins_inc = VIRTUAL_LOSS + add;
-
-                    #pragma omp atomic
-                    n->wins += wins_inc;
-                }
-            }
-            double back_end = omp_get_wtime();
-            back_time += (back_end - back_start);
-        } 
+            if (sampled) probe_lap(probe, PHASE_EXPANSION, &mark);
+
+            if (done) break;
+        }
+
+        // Simulation
+        double result = evaluate_leaf(node, config, rng);
+        if (sampled) probe_lap(probe, PHASE_SIMULATION, &mark);
+
+        // Backpropagation: the first virtual visit becomes the real one,
+        // any others are returned, all in the same atomic add
+        int original_player = node_player(node);
+        for (int p = 0; p < path_len; ++p) {
+            Node *n = path[p];
+            double add = n->player_just_moved == original_player ? result : 1.0 - result;
+            uint64_t delta = stats_result(add) - virtual_loss;
+            node_add_stats(n, delta);
+
+            if (tt != NULL) tt_update(tt, n->hash, add);
+        }
+        if (sampled) {
+            probe_lap(probe, PHASE_BACKPROPAGATION, &mark);
+            probe->samples++;
+        }
     }
+    return iterations;
+}
+
+static void tree_search_task(void *arg, int index, int worker) {
+    TreeSearch *search = arg;
+    RNG thread_rng;
+    rng_seed_stream(&thread_rng, search->seed_base, (uint64_t)index);
+    NodeArena *arena = node_pool_arena_at(search->pool, worker);
+
+    PhaseProbe probe;
+    probe_start(&probe);
+    int iterations = PROBE_DISPATCH(search->config,
+        tree_search_loop(search, arena, &thread_rng, &probe, 1),
+        tree_search_loop(search, arena, &thread_rng, &probe, 0));
+    probe_finish(&probe, iterations, &search->timings[index]);
+    search->timings[index].iterations = iterations;
+}
+
+// MCTS root parallel with virtual loss approach. Despite the name this is
+// tree parallelism: all threads share one tree with no locks. Each step of
+// a path is one atomic add on the node's packed stats, and leaves are
+// claimed for expansion with a compare-and-swap on expand_state.
+MCTSTiming mcts_root_parallel_virtual_loss(Node *root, NodePool *pool, TaskPool *tasks, TranspositionTable *tt,
+                                           const MCTSConfig *config, const SearchLimits *limits, RNG *rng) {
+    MCTSTiming timing = {0.0, 0.0, 0.0, 0.0, 0.0, 0};
     
-    timing.selection = sel_time;
-    timing.expansion = exp_time;
-    timing.simulation = sim_time;
-    timing.backpropagation = back_time;
+    if (root == NULL) return timing;
+
+    double total_start = omp_get_wtime();
+    SearchBudget budget;
+    budget_start(&budget, limits);
+
+    int num_threads = task_pool_size(tasks);
+    if (!node_pool_reserve(pool, num_threads)) return timing;
+
+    TreeSearch search = {root, pool, tt, config, &budget, 0, rng_next(rng),
+                         calloc(num_threads, sizeof(MCTSTiming))};
+    if (search.timings == NULL) return timing;
+    task_pool_run(tasks, tree_search_task, &search, num_threads);
+
+    // Track cumulative times across all threads
+    for (int t = 0; t < num_threads; t++) {
+        timing.selection += search.timings[t].selection;
+        timing.expansion += search.timings[t].expansion;
+        timing.simulation += search.timings[t].simulation;
+        timing.backpropagation += search.timings[t].backpropagation;
+        timing.iterations += search.timings[t].iterations;
+    }
+    free(search.timings);
     
     double total_end = omp_get_wtime();
     timing.total = total_end - total_start;
     
     return timing;
-}
+}
\ No newline at end of file
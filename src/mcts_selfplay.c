@@ -0,0 +1,277 @@
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#ifdef MCTS_ZLIB
+#include <zlib.h>
+#endif
+
+#include "mcts_selfplay.h"
+
+// WRITER
+
+int selfplay_compression_available(void) {
+#ifdef MCTS_ZLIB
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+static int write_buffer(SelfPlayWriter *writer, const SelfPlayBuffer *buffer) {
+#ifdef MCTS_ZLIB
+    if (writer->gz != NULL)
+        return gzwrite(writer->gz, buffer->data, (unsigned)buffer->used) == (int)buffer->used;
+#endif
+    return fwrite(buffer->data, 1, buffer->used, writer->file) == buffer->used;
+}
+
+// Write full buffers in the order they were handed over, then recycle them
+static void* writer_thread(void *arg) {
+    SelfPlayWriter *writer = arg;
+    pthread_mutex_lock(&writer->lock);
+    for (;;) {
+        while (writer->full_head == NULL && !writer->closing)
+            pthread_cond_wait(&writer->filled, &writer->lock);
+        SelfPlayBuffer *buffer = writer->full_head;
+        if (buffer == NULL) break;
+        writer->full_head = buffer->next;
+        if (writer->full_head == NULL) writer->full_tail = NULL;
+        pthread_mutex_unlock(&writer->lock);
+
+        // After an error the data is dropped but buffers keep flowing, so
+        // workers never block on a writer that has given up
+        int ok = !writer->error && write_buffer(writer, buffer);
+
+        pthread_mutex_lock(&writer->lock);
+        if (ok) {
+            writer->bytes += buffer->used;
+            writer->writes++;
+        } else {
+            writer->error = 1;
+        }
+        buffer->used = 0;
+        buffer->next = writer->spare;
+        writer->spare = buffer;
+        pthread_cond_signal(&writer->emptied);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+
+// Open path for records with buffers chunks of SELFPLAY_BUFFER_BYTES in
+// rotation. Returns 0 if the file cannot be created, or compression was
+// asked for in a build without zlib.
+int selfplay_writer_open(SelfPlayWriter *writer, const char *path, int compress, int buffers) {
+    memset(writer, 0, sizeof(*writer));
+    if (compress) {
+#ifdef MCTS_ZLIB
+        writer->gz = gzopen(path, "wb1");   // Fastest level keeps pace with the workers
+        if (writer->gz == NULL) return 0;
+#else
+        return 0;
+#endif
+    } else {
+        writer->file = fopen(path, "wb");
+        if (writer->file == NULL) return 0;
+        setvbuf(writer->file, NULL, _IONBF, 0);   // Buffers are already large
+    }
+
+    writer->buffers = calloc(buffers, sizeof(SelfPlayBuffer *));
+    for (int i = 0; writer->buffers != NULL && i < buffers; i++) {
+        SelfPlayBuffer *buffer = malloc(sizeof(SelfPlayBuffer) + SELFPLAY_BUFFER_BYTES);
+        if (buffer == NULL) break;
+        buffer->used = 0;
+        buffer->next = writer->spare;
+        writer->spare = buffer;
+        writer->buffers[writer->num_buffers++] = buffer;
+    }
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->filled, NULL);
+    pthread_cond_init(&writer->emptied, NULL);
+    if (writer->num_buffers < buffers || pthread_create(&writer->thread, NULL, writer_thread, writer) != 0) {
+        writer->closing = -1;   // No thread to join
+        selfplay_writer_close(writer);
+        return 0;
+    }
+    return 1;
+}
+
+// Queue full (may be NULL) for writing and return an empty buffer, waiting
+// only if every buffer is still queued
+SelfPlayBuffer* selfplay_writer_submit(SelfPlayWriter *writer, SelfPlayBuffer *full) {
+    pthread_mutex_lock(&writer->lock);
+    if (full != NULL && full->used > 0) {
+        full->next = NULL;
+        if (writer->full_tail != NULL) writer->full_tail->next = full;
+        else writer->full_head = full;
+        writer->full_tail = full;
+        pthread_cond_signal(&writer->filled);
+    } else if (full != NULL) {
+        full->next = writer->spare;
+        writer->spare = full;
+    }
+    while (writer->spare == NULL)
+        pthread_cond_wait(&writer->emptied, &writer->lock);
+    SelfPlayBuffer *empty = writer->spare;
+    writer->spare = empty->next;
+    pthread_mutex_unlock(&writer->lock);
+    return empty;
+}
+
+// Write everything still queued and close the file, keeping the byte and
+// write counts. Returns 0 if any write failed.
+int selfplay_writer_close(SelfPlayWriter *writer) {
+    if (writer->closing != -1) {
+        pthread_mutex_lock(&writer->lock);
+        writer->closing = 1;
+        pthread_cond_signal(&writer->filled);
+        pthread_mutex_unlock(&writer->lock);
+        pthread_join(writer->thread, NULL);
+    }
+
+    int ok = !writer->error;
+#ifdef MCTS_ZLIB
+    if (writer->gz != NULL && gzclose(writer->gz) != Z_OK) ok = 0;
+#endif
+    if (writer->file != NULL && fclose(writer->file) != 0) ok = 0;
+    for (int i = 0; i < writer->num_buffers; i++) free(writer->buffers[i]);
+    free(writer->buffers);
+    pthread_cond_destroy(&writer->emptied);
+    pthread_cond_destroy(&writer->filled);
+    pthread_mutex_destroy(&writer->lock);
+    writer->file = NULL;
+    writer->gz = NULL;
+    writer->buffers = NULL;
+    writer->num_buffers = 0;
+    writer->spare = NULL;
+    return ok;
+}
+
+// GAMES
+
+typedef struct {
+    const SelfPlayOptions *options;
+    MCTSEngine *engines;            // One per pool worker
+    SelfPlayBuffer **current;       // Each worker's buffer being filled
+    SelfPlayWriter *writer;
+    long records;
+    int games;
+} SelfPlayJob;
+
+// Record the searched root and choose the move to play: in proportion to
+// visits early in the game, the engine's choice after that
+static int record_position(SelfPlayRecord *record, MCTSEngine *engine, const GameState *state,
+                           int ply, int best, int sample) {
+    const Node *root = engine->tree.root;
+    uint32_t total = 0;
+    for (int i = 0; i < root->num_children; i++) total += node_visits(&root->children[i]);
+
+    memset(record, 0, sizeof(*record));
+    record->black = state->black;
+    record->white = state->white;
+    record->player = (uint8_t)state->player;
+    record->ply = (uint8_t)ply;
+    record->root_visits = total;
+    for (int i = 0; total > 0 && i < root->num_children; i++) {
+        const Node *child = &root->children[i];
+        record->policy[child->move] =
+            (uint16_t)((uint64_t)node_visits(child) * SELFPLAY_POLICY_SCALE / total);
+    }
+
+    int move = best;
+    if (sample && total > 0) {
+        uint32_t pick = rng_bounded(&engine->rng, total);
+        for (int i = 0; i < root->num_children; i++) {
+            uint32_t visits = node_visits(&root->children[i]);
+            if (pick < visits) {
+                move = root->children[i].move;
+                break;
+            }
+            pick -= visits;
+        }
+    }
+    record->move = (uint8_t)move;
+    return move;
+}
+
+// Play one game on the worker's engine and append its records to the
+// worker's buffer once the outcome is known
+static void selfplay_game(void *arg, int index, int worker) {
+    (void)index;
+    SelfPlayJob *job = arg;
+    MCTSEngine *engine = &job->engines[worker];
+    SelfPlayRecord records[SIZE * SIZE];
+    int count = 0;
+
+    GameState state;
+    init_board(&state);
+    mcts_engine_new_game(engine, &state);
+    while (count < SIZE * SIZE) {
+        if (!has_valid_moves(&state)) {
+            pass_turn(&state);
+            if (!has_valid_moves(&state)) break;
+        }
+        MCTSResult result;
+        if (!mcts_engine_search(engine, &state, &job->options->limits, &result)) break;
+        int move = record_position(&records[count], engine, &state, count, result.move,
+                                   count < job->options->sample_plies);
+        count++;
+        make_move_square(&state, move);
+    }
+
+    int winner = get_winner(&state);
+    for (int i = 0; i < count; i++)
+        records[i].outcome = winner == 0 ? 0 : (winner == records[i].player ? 1 : -1);
+
+    size_t bytes = count * sizeof(SelfPlayRecord);
+    SelfPlayBuffer *buffer = job->current[worker];
+    if (buffer->used + bytes > SELFPLAY_BUFFER_BYTES)
+        buffer = job->current[worker] = selfplay_writer_submit(job->writer, buffer);
+    memcpy(buffer->data + buffer->used, records, bytes);
+    buffer->used += bytes;
+
+    __atomic_add_fetch(&job->records, count, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&job->games, 1, __ATOMIC_RELAXED);
+}
+
+// Play options->games self-play games spread over the pool's workers, each
+// on its own engine built from config, and stream their records to path.
+// Returns 0 if the output could not be written.
+int selfplay_run(TaskPool *tasks, const MCTSConfig *config, const SelfPlayOptions *options,
+                 const char *path, SelfPlayReport *report) {
+    int workers = task_pool_size(tasks);
+    SelfPlayWriter writer;
+    if (!selfplay_writer_open(&writer, path, options->compress, 2 * workers + 2)) return 0;
+
+    SelfPlayJob job = {options, calloc(workers, sizeof(MCTSEngine)),
+                       calloc(workers, sizeof(SelfPlayBuffer *)), &writer, 0, 0};
+    int ok = job.engines != NULL && job.current != NULL;
+    int ready = 0;
+    for (; ok && ready < workers; ready++) {
+        MCTSConfig engine_config = *config;
+        engine_config.seed = config->seed + ready;
+        ok = mcts_engine_init(&job.engines[ready], &engine_config, tasks);
+        if (ok) job.current[ready] = selfplay_writer_submit(&writer, NULL);
+        else break;
+    }
+
+    double start = omp_get_wtime();
+    if (ok) task_pool_run(tasks, selfplay_game, &job, options->games);
+    for (int w = 0; w < ready; w++) selfplay_writer_submit(&writer, job.current[w]);
+    ok = selfplay_writer_close(&writer) && ok;
+    double elapsed = omp_get_wtime() - start;
+
+    for (int w = 0; w < ready; w++) mcts_engine_destroy(&job.engines[w]);
+    free(job.engines);
+    free(job.current);
+
+    report->games = job.games;
+    report->records = job.records;
+    report->bytes = job.records * sizeof(SelfPlayRecord);
+    report->writes = writer.writes;
+    report->elapsed = elapsed;
+    report->records_per_sec = elapsed > 0.0 ? job.records / elapsed : 0.0;
+    report->mb_per_sec = elapsed > 0.0 ? report->bytes / elapsed / (1 << 20) : 0.0;
+    return ok;
+}
\ No newline at end of file
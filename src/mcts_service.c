@@ -0,0 +1,147 @@
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+
+#include "mcts_service.h"
+
+// Set up num_games engines with config on the shared pool. Game g is
+// seeded with config->seed + g. Returns 0 on allocation failure.
+int service_init(SearchService *service, TaskPool *tasks, int num_games,
+                 const MCTSConfig *config, const SearchLimits *limits) {
+    service->tasks = tasks;
+    service->num_games = num_games;
+    service->games = calloc(num_games, sizeof(ServiceGame));
+    if (service->games == NULL) return 0;
+    pthread_mutex_init(&service->lock, NULL);
+
+    MCTSConfig game_config = *config;
+    for (int g = 0; g < num_games; g++) {
+        game_config.seed = config->seed + g;
+        if (!mcts_engine_init(&service->games[g].engine, &game_config, tasks)) {
+            service->num_games = g;
+            return 0;
+        }
+        service->games[g].limits = *limits;
+    }
+    return 1;
+}
+
+void service_destroy(SearchService *service) {
+    for (int g = 0; g < service->num_games; g++)
+        mcts_engine_destroy(&service->games[g].engine);
+    pthread_mutex_destroy(&service->lock);
+    free(service->games);
+    service->games = NULL;
+    service->num_games = 0;
+}
+
+// When a waiting game's move is due: its request time plus its time budget
+static double move_deadline(const ServiceGame *game) {
+    return game->requested + (game->limits.seconds > 0.0 ? game->limits.seconds : 0.0);
+}
+
+// Earliest-deadline waiting game, or NULL. Caller holds the lock.
+static ServiceGame* next_game(SearchService *service) {
+    ServiceGame *best = NULL;
+    for (int g = 0; g < service->num_games; g++) {
+        ServiceGame *game = &service->games[g];
+        if (game->running || game->finished) continue;
+        if (best == NULL || move_deadline(game) < move_deadline(best)) best = game;
+    }
+    return best;
+}
+
+// Advance one game by a move (or a pass). Only the worker that claimed it
+// touches its state and engine.
+static void play_move(ServiceGame *game) {
+    GameState *state = &game->state;
+    if (!has_valid_moves(state)) {
+        pass_turn(state);
+        if (!has_valid_moves(state)) {
+            game->finished = 1;
+            return;
+        }
+    }
+
+    MCTSResult result;
+    if (!mcts_engine_search(&game->engine, state, &game->limits, &result)) {
+        game->finished = 1;
+        return;
+    }
+    make_move_square(state, result.move);
+    game->latencies[game->moves++] = omp_get_wtime() - game->requested;
+}
+
+// A worker's scheduling loop. It leaves as soon as no game is waiting:
+// every game that becomes ready again does so in the worker that just
+// moved it, which then loops, so no ready game is ever left without one.
+static void service_worker(void *arg, int index, int worker) {
+    (void)index;
+    (void)worker;
+    SearchService *service = arg;
+
+    pthread_mutex_lock(&service->lock);
+    ServiceGame *game = next_game(service);
+    while (game != NULL) {
+        game->running = 1;
+        pthread_mutex_unlock(&service->lock);
+
+        play_move(game);
+
+        pthread_mutex_lock(&service->lock);
+        game->running = 0;
+        game->requested = omp_get_wtime();
+        game = next_game(service);
+    }
+    pthread_mutex_unlock(&service->lock);
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, long count, double p) {
+    if (count == 0) return 0.0;
+    long i = (long)ceil(p * count) - 1;
+    return sorted[i < 0 ? 0 : (i >= count ? count - 1 : i)];
+}
+
+// Play every game from the start position to the end and report
+// throughput and per-move latency
+void service_play(SearchService *service, ServiceReport *report) {
+    double start = omp_get_wtime();
+    for (int g = 0; g < service->num_games; g++) {
+        ServiceGame *game = &service->games[g];
+        init_board(&game->state);
+        mcts_engine_new_game(&game->engine, &game->state);
+        game->requested = start;
+        game->running = 0;
+        game->finished = 0;
+        game->moves = 0;
+    }
+
+    task_pool_run(service->tasks, service_worker, service, task_pool_size(service->tasks));
+    double elapsed = omp_get_wtime() - start;
+
+    long moves = 0;
+    for (int g = 0; g < service->num_games; g++)
+        moves += service->games[g].moves;
+    double *latencies = malloc((moves > 0 ? moves : 1) * sizeof(double));
+    long n = 0;
+    for (int g = 0; g < service->num_games; g++)
+        for (int m = 0; m < service->games[g].moves; m++)
+            latencies[n++] = service->games[g].latencies[m];
+    qsort(latencies, n, sizeof(double), compare_double);
+
+    report->games = service->num_games;
+    report->moves = moves;
+    report->elapsed = elapsed;
+    report->moves_per_sec = elapsed > 0.0 ? moves / elapsed : 0.0;
+    report->games_per_sec = elapsed > 0.0 ? service->num_games / elapsed : 0.0;
+    report->latency_p50 = percentile(latencies, n, 0.50);
+    report->latency_p90 = percentile(latencies, n, 0.90);
+    report->latency_p99 = percentile(latencies, n, 0.99);
+    report->latency_max = n > 0 ? latencies[n - 1] : 0.0;
+    free(latencies);
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <omp.h>
+#include <limits.h>
+#include "mcts_tree.h"
+
+#define POSITION_SEARCH_DEPTH 2  // Our move plus the opponent's reply
+
+static int same_position(const Node *node, const GameState *state) {
+    return node->hash == state->hash && node->black == state->black &&
+           node->white == state->white && node_player(node) == state->player;
+}
+
+// Depth-limited search for the node holding state
+static Node* find_position(Node *node, const GameState *state, int depth) {
+    if (same_position(node, state)) return node;
+    if (depth == 0) return NULL;
+    for (int i = 0; i < node->num_children; i++) {
+        Node *found = find_position(&node->children[i], state, depth - 1);
+        if (found != NULL) return found;
+    }
+    return NULL;
+}
+
+static void copy_node(Node *dst, const Node *src, Node *parent) {
+    *dst = *src;
+    dst->parent = parent;
+    dst->children = NULL;
+}
+
+// Deep copy src's children, and depth levels below them, under dst. Nodes
+// at the cut keep their statistics but are left unexpanded.
+static void copy_subtree(NodeArena *arena, Node *dst, const Node *src, int depth) {
+    if (src->num_children == 0 || src->children == NULL || depth <= 0) {
+        if (dst->num_children > 0) dst->expand_state = NODE_UNEXPANDED;
+        dst->num_children = 0;
+        return;
+    }
+
+    dst->children = arena_alloc(arena, src->num_children * sizeof(Node));
+    for (int i = 0; i < src->num_children; i++)
+        copy_node(&dst->children[i], &src->children[i], dst);
+    for (int i = 0; i < src->num_children; i++)
+        copy_subtree(arena, &dst->children[i], &src->children[i], depth - 1);
+}
+
+// Parentless copy of root and depth levels of its subtree, statistics
+// included, allocated in arena
+Node* tree_copy(NodeArena *arena, const Node *root, int depth) {
+    Node *copy = arena_alloc(arena, sizeof(Node));
+    copy_node(copy, root, NULL);
+    copy_subtree(arena, copy, root, depth);
+    return copy;
+}
+
+// Make node the new root, keeping its subtree and dropping everything else
+static void reroot(MCTSTree *tree, Node *node) {
+    int spare = 1 - tree->live;
+    Node *root = tree_copy(node_pool_arena(&tree->pools[spare]), node, INT_MAX);
+    root->move = -1;
+
+    node_pool_reset(&tree->pools[tree->live]);
+    tree->live = spare;
+    tree->root = root;
+}
+
+void tree_init(MCTSTree *tree, const GameState *state) {
+    node_pool_init(&tree->pools[0], omp_get_max_threads());
+    node_pool_init(&tree->pools[1], 1);
+    tree->live = 0;
+    tree->root = create_node(node_pool_arena(&tree->pools[0]), state, -1, NULL);
+}
+
+void tree_destroy(MCTSTree *tree) {
+    node_pool_destroy(&tree->pools[0]);
+    node_pool_destroy(&tree->pools[1]);
+    tree->root = NULL;
+}
+
+// Pool that search modes should grow the tree into
+NodePool* tree_pool(MCTSTree *tree) {
+    return &tree->pools[tree->live];
+}
+
+// Throw away the whole tree and start again from state
+void tree_reset(MCTSTree *tree, const GameState *state) {
+    node_pool_reset(&tree->pools[0]);
+    node_pool_reset(&tree->pools[1]);
+    tree->root = create_node(node_pool_arena(&tree->pools[tree->live]), state, -1, NULL);
+}
+
+// Advance the root by one ply (move is a square, or -1 for a pass).
+// Returns the number of visits carried over into the new root.
+int tree_advance(MCTSTree *tree, int move) {
+    for (int i = 0; i < tree->root->num_children; i++) {
+        Node *child = &tree->root->children[i];
+        if (child->move == move) {
+            reroot(tree, child);
+            return node_visits(tree->root);
+        }
+    }
+
+    GameState state = node_state(tree->root);
+    if (move < 0) pass_turn(&state);
+    else make_move_square(&state, move);
+    tree_reset(tree, &state);
+    return 0;
+}
+
+// Move the root to state, reusing the matching subtree if state is within
+// our move and the opponent's reply of the current root. Returns the
+// number of visits carried over (0 when the tree had to be rebuilt).
+int tree_set_position(MCTSTree *tree, const GameState *state) {
+    Node *match = find_position(tree->root, state, POSITION_SEARCH_DEPTH);
+    if (match == NULL) {
+        tree_reset(tree, state);
+        return 0;
+    }
+    if (match != tree->root) reroot(tree, match);
+    return node_visits(tree->root);
+}
+
+size_t tree_bytes_used(const MCTSTree *tree) {
+    return node_pool_bytes_used(&tree->pools[0]) + node_pool_bytes_used(&tree->pools[1]);
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcts_tt.h"
+
+#define TT_VISIT (1ULL << 32)
+
+static inline TTEntry* tt_bucket(const TranspositionTable *tt, uint64_t key) {
+    return &tt->entries[(key & (tt->num_buckets - 1)) * TT_BUCKET_SIZE];
+}
+
+// Allocate a table using at most bytes of memory (rounded down to a power
+// of two number of buckets). Returns 0 on allocation failure.
+int tt_init(TranspositionTable *tt, size_t bytes) {
+    size_t bucket_bytes = TT_BUCKET_SIZE * sizeof(TTEntry);
+    size_t buckets = 1;
+    while (buckets * 2 * bucket_bytes <= bytes)
+        buckets *= 2;
+
+    tt->entries = aligned_alloc(64, buckets * bucket_bytes);
+    tt->num_buckets = tt->entries != NULL ? buckets : 0;
+    if (tt->entries == NULL) return 0;
+    tt_clear(tt);
+    return 1;
+}
+
+void tt_clear(TranspositionTable *tt) {
+    memset(tt->entries, 0, tt->num_buckets * TT_BUCKET_SIZE * sizeof(TTEntry));
+}
+
+void tt_destroy(TranspositionTable *tt) {
+    free(tt->entries);
+    tt->entries = NULL;
+    tt->num_buckets = 0;
+}
+
+// Read the shared statistics for key. Returns 0 if the position is not stored.
+int tt_lookup(const TranspositionTable *tt, uint64_t key, int *visits, double *wins) {
+    TTEntry *bucket = tt_bucket(tt, key);
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        if (__atomic_load_n(&bucket[i].key, __ATOMIC_RELAXED) == key) {
+            uint64_t stats = __atomic_load_n(&bucket[i].stats, __ATOMIC_RELAXED);
+            *visits = (int)(stats >> 32);
+            *wins = (uint32_t)stats * 0.5;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Add one result (from the perspective of the player who moved into the
+// position) to key's entry. A missing key takes over the bucket's least
+// visited entry. Safe to call from several threads; two threads claiming
+// the same slot at once can at worst mix one result into the wrong entry.
+void tt_update(TranspositionTable *tt, uint64_t key, double result) {
+    uint64_t delta = TT_VISIT + (uint64_t)(result * 2.0 + 0.5);
+    TTEntry *bucket = tt_bucket(tt, key);
+    TTEntry *victim = &bucket[0];
+    uint64_t victim_visits = UINT64_MAX;
+
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        uint64_t k = __atomic_load_n(&bucket[i].key, __ATOMIC_RELAXED);
+        if (k == key) {
+            __atomic_fetch_add(&bucket[i].stats, delta, __ATOMIC_RELAXED);
+            return;
+        }
+        uint64_t visits = k == 0 ? 0 : __atomic_load_n(&bucket[i].stats, __ATOMIC_RELAXED) >> 32;
+        if (visits < victim_visits) {
+            victim_visits = visits;
+            victim = &bucket[i];
+        }
+    }
+
+    __atomic_store_n(&victim->key, key, __ATOMIC_RELAXED);
+    __atomic_store_n(&victim->stats, delta, __ATOMIC_RELAXED);
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <math.h>
+#include <string.h>
+
+#include "mcts.h"
+#include "mcts_ucb.h"
+
+#define UCB_MAX_CHILDREN (SIZE * SIZE)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define UCB_X86 1
+#else
+#define UCB_X86 0
+#endif
+
+#if UCB_X86
+// AVX: four children per vector
+#define UCB_LANES 4
+#define UCB_NAME(name) ucb_##name##_avx
+#define UCB_SQRT(v) __builtin_ia32_sqrtpd256(v)
+#pragma GCC push_options
+#pragma GCC target("avx")
+#include "mcts_ucb_kernel.h"
+#pragma GCC pop_options
+#undef UCB_LANES
+#undef UCB_NAME
+#undef UCB_SQRT
+
+// SSE2 (always present on x86-64): two children per vector
+#define UCB_LANES 2
+#define UCB_NAME(name) ucb_##name##_sse2
+#define UCB_SQRT(v) __builtin_ia32_sqrtpd(v)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#include "mcts_ucb_kernel.h"
+#pragma GCC pop_options
+#undef UCB_LANES
+#undef UCB_NAME
+#undef UCB_SQRT
+#endif
+
+// Portable fallback: one child at a time
+static void ucb_scores_scalar(const double *wins, const double *value_visits,
+                              const double *visits, int count, double explore,
+                              double *scores) {
+    for (int i = 0; i < count; i++)
+        scores[i] = wins[i] / value_visits[i] + explore / sqrt(visits[i]);
+}
+
+typedef void (*UCBKernel)(const double *wins, const double *value_visits,
+                          const double *visits, int count, double explore,
+                          double *scores);
+
+// Widest kernel the CPU supports, chosen once at load time so selection
+// does not probe the CPU on every step
+static UCBKernel ucb_scores = ucb_scores_scalar;
+
+__attribute__((constructor))
+static void select_ucb_kernel(void) {
+#if UCB_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) ucb_scores = ucb_scores_avx;
+    else if (__builtin_cpu_supports("sse2")) ucb_scores = ucb_scores_sse2;
+#endif
+}
+
+#define UCB_LANES_MAX 4
+
+// sqrt(log(n)) for small parent visit counts. Filled once at load time so
+// lookups need no synchronization; the UCB constant is applied per call.
+static double explore_table[UCB_TABLE_SIZE];
+
+__attribute__((constructor))
+static void init_explore_table(void) {
+    explore_table[0] = 0.0;
+    for (int n = 1; n < UCB_TABLE_SIZE; n++)
+        explore_table[n] = sqrt(log(n));
+}
+
+static inline double explore_factor(int parent_visits) {
+    if (parent_visits < UCB_TABLE_SIZE) return explore_table[parent_visits < 0 ? 0 : parent_visits];
+    return sqrt(log(parent_visits));
+}
+
+// Index of the child UCB1 prefers, or -1 when every child is a proven loss
+// for the side choosing. Unvisited children and proven wins are taken at
+// once, in child order; otherwise the children's statistics are gathered
+// into flat arrays and scored together by the widest kernel available.
+int ucb_select(const Node *node, TranspositionTable *tt, double ucb_constant) {
+    _Alignas(32) double wins[UCB_MAX_CHILDREN + UCB_LANES_MAX];
+    _Alignas(32) double value_visits[UCB_MAX_CHILDREN + UCB_LANES_MAX];
+    _Alignas(32) double visits[UCB_MAX_CHILDREN + UCB_LANES_MAX];
+    _Alignas(32) double scores[UCB_MAX_CHILDREN + UCB_LANES_MAX];
+
+    int count = node->num_children;
+    for (int i = 0; i < count; i++) {
+        const Node *child = &node->children[i];
+        int proven = node_proven(child);
+        if (proven == PROVEN_WIN) return i;
+        if (proven == PROVEN_LOSS) {
+            wins[i] = -INFINITY;
+            value_visits[i] = visits[i] = 1.0;
+            continue;
+        }
+
+        uint64_t stats = node_load_stats(child);
+        int v = stats_visits(stats);
+        if (v == 0) return i;
+
+        // Exploitation uses the transposition table's larger sample when
+        // other move orders reached the position; exploration keeps the
+        // node's own visit count
+        int tt_visits;
+        double tt_wins;
+        if (tt != NULL && tt_lookup(tt, child->hash, &tt_visits, &tt_wins) && tt_visits > v) {
+            wins[i] = tt_wins;
+            value_visits[i] = tt_visits;
+        } else {
+            wins[i] = stats_wins(stats);
+            value_visits[i] = v;
+        }
+        visits[i] = v;
+    }
+
+    // Pad the last vector with lanes that can never win
+    int padded = (count + UCB_LANES_MAX - 1) & ~(UCB_LANES_MAX - 1);
+    for (int i = count; i < padded; i++) {
+        wins[i] = -INFINITY;
+        value_visits[i] = visits[i] = 1.0;
+    }
+
+    double explore = ucb_constant * explore_factor(node_visits(node));
+    ucb_scores(wins, value_visits, visits, padded, explore, scores);
+
+    int best = -1;
+    double best_score = -INFINITY;
+    for (int i = 0; i < count; i++) {
+        if (scores[i] > best_score) {
+            best_score = scores[i];
+            best = i;
+        }
+    }
+    return best;
+}
\ No newline at end of file
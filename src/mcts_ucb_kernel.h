@@ -0,0 +1,26 @@
+// UCB1 scoring kernel, included by mcts_ucb.c once per instruction set. The
+// includer defines UCB_LANES, UCB_NAME(name) and UCB_SQRT(vec), the
+// lane-wise square root for that instruction set.
+//
+// Inputs are struct-of-arrays child statistics padded to a multiple of
+// UCB_LANES, so every child is scored in one pass of full-width vectors.
+
+typedef double UCB_NAME(vec) __attribute__((vector_size(UCB_LANES * sizeof(double))));
+#define UcbVec UCB_NAME(vec)
+
+// scores[i] = wins[i] / value_visits[i] + explore / sqrt(visits[i]), where
+// explore is the UCB constant times sqrt(log(parent visits))
+static void UCB_NAME(scores)(const double *wins, const double *value_visits,
+                             const double *visits, int count, double explore,
+                             double *scores) {
+    for (int i = 0; i < count; i += UCB_LANES) {
+        UcbVec w, n, v;
+        memcpy(&w, wins + i, sizeof(UcbVec));
+        memcpy(&n, value_visits + i, sizeof(UcbVec));
+        memcpy(&v, visits + i, sizeof(UcbVec));
+        UcbVec s = w / n + explore / UCB_SQRT(v);
+        memcpy(scores + i, &s, sizeof(UcbVec));
+    }
+}
+
+#undef UcbVec
@@ -2,50 +2,51 @@
 
 // NODE FUNCTIONS
 
-// Deep copy a MCTS node and its entire subtree
-Node* clone_node(Node *original, Node *new_parent) {
+// Copy a single MCTS node's position, move and proof, with zeroed
+// statistics and no children (tree_copy copies whole subtrees)
+Node* clone_node(NodeArena *arena, Node *original, Node *new_parent) {
     if (original == NULL) return NULL;
 
-    Node *clone = malloc(sizeof(Node));
-    clone->state = original->state;
-    clone->move_row = original->move_row;
-    clone->move_col = original->move_col;
-    clone->visits = 0;
-    clone->wins = 0.0;
+    Node *clone = arena_alloc(arena, sizeof(Node));
+    clone->black = original->black;
+    clone->white = original->white;
+    clone->hash = original->hash;
+    clone->move = original->move;
+    clone->stats = 0;
     clone->parent = new_parent;
     clone->player_just_moved = original->player_just_moved;
     clone->num_children = 0;
+    clone->proven = original->proven;
+    clone->expand_state = NODE_UNEXPANDED;
     clone->children = NULL;
 
     return clone;
 }
 
-// Make a MCTS tree node
-Node* create_node(GameState *state, int r, int c, Node *parent) {
-    Node *node = malloc(sizeof(Node));
-    node->state = *state;
-    node->move_row = r;
-    node->move_col = c;
-    node->visits = 0;
-    node->wins = 0.0;
-    node->parent = parent;
-    node->children = NULL;
+// Initialize a MCTS tree node in place (e.g. inside a children array)
+void init_node(Node *node, const GameState *state, int move, Node *parent) {
+    node->stats = 0;
+    node->move = (signed char)move;
+    node->player_just_moved = (unsigned char)opponent(state->player);
     node->num_children = 0;
-    node->player_just_moved = parent ? opponent(state->player) : BLACK;
-    omp_init_lock(&node->lock);
-    return node;
+    node->proven = PROVEN_NONE;
+    node->expand_state = NODE_UNEXPANDED;
+    node->children = NULL;
+    node->parent = parent;
+    node->black = state->black;
+    node->white = state->white;
+    node->hash = state->hash;
 }
 
-// Free a MCTS tree
-void free_tree(Node *node) {
-    if (node == NULL) return;
-    for (int i = 0; i < node->num_children; i++)
-        free_tree(node->children[i]);
-    free(node->children);
-    free(node);
+// Make a MCTS tree node
+Node* create_node(NodeArena *arena, const GameState *state, int move, Node *parent) {
+    Node *node = arena_alloc(arena, sizeof(Node));
+    init_node(node, state, move, parent);
+    return node;
 }
 
 
+
 // TIMING FUNCTIONS
 
 // Initialize aggregator
@@ -82,6 +83,11 @@ MCTSTiming get_average_timing(const MCTSTimingAggregator *agg) {
 // Print timing statistics
 void print_timing(const MCTSTiming *timing, int iterations, const char *label) {
     printf("\n=== MCTS Phase Timing: %s (%d iterations) ===\n", label, iterations);
+    if (timing->total <= 0.0) {
+        printf("No phase samples (probes disabled)\n");
+        printf("=================================================\n\n");
+        return;
+    }
     printf("Selection:       %.6f s (%.2f%%)\n", timing->selection, 
            100.0 * timing->selection / timing->total);
     printf("Expansion:       %.6f s (%.2f%%)\n", timing->expansion, 
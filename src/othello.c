@@ -1,15 +1,87 @@
 #include "othello.h"
 
-int dx[] = {-1, -1, -1, 0, 0, 1, 1, 1};
-int dy[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+#define FILE_A 0x0101010101010101ULL
+#define FILE_H 0x8080808080808080ULL
+
+// Ray directions as bitboard shift amounts. Each amount is used once as a
+// left shift and once as a right shift; the masks drop bits that wrapped
+// around to the opposite edge of the board.
+static const int dir_shift[4] = {1, 7, 8, 9};
+static const uint64_t left_mask[4] = {~FILE_A, ~FILE_H, ~0ULL, ~FILE_A};
+static const uint64_t right_mask[4] = {~FILE_H, ~FILE_A, ~0ULL, ~FILE_H};
+
+static const uint64_t zobrist_black[SIZE * SIZE] = {
+    0x982b565bd1e2bbc0ULL, 0x27767d3a973e775fULL, 0xb705ccbc3dc9d860ULL, 0xb2ef37347ee0d020ULL,
+    0x87be1ca5d7b24227ULL, 0xba9298e42c46adb8ULL, 0x10ac956cf6ac894fULL, 0xef8d63a8918838b5ULL,
+    0xac9c2b3b71cfccb3ULL, 0xc3c202fdc1495486ULL, 0x116e36eff97c098fULL, 0xdc2ce06d2d94c360ULL,
+    0xde3bccf008fe46acULL, 0x1d104adeee786a2eULL, 0x458fc3bfbf048d4cULL, 0x4e4a8fb23db0da9dULL,
+    0x4e0ed64d48420f28ULL, 0xb07d9d27933508abULL, 0x20ba6a33478710feULL, 0xcdcc79b713ce723cULL,
+    0xeab145cf2e2cf771ULL, 0x8ca91b7057c3a1e8ULL, 0x4466a194a43f17fdULL, 0xa00b72baefa96deeULL,
+    0x9f1b96e28a5c951dULL, 0xd9aa34e2e40f882bULL, 0x569a07b7d7ba1c18ULL, 0x425b10e27f2afda2ULL,
+    0xfaa66d59fb925e74ULL, 0x652d37119b7e2a3fULL, 0x9af52b4ee779e0acULL, 0xc169445ebf06389aULL,
+    0x17a4a3f318e3a523ULL, 0xb6042d215f1f6280ULL, 0x5a6acdb020ac0bf9ULL, 0xebcccc70bd541b02ULL,
+    0xfdd4398123424993ULL, 0x126c67b615b485adULL, 0x2fb85d9bd6112450ULL, 0x421b186859dbfd80ULL,
+    0x209937eeb79b4bc1ULL, 0xf8649fb2035c61c0ULL, 0x2f60bf7c4fcd4504ULL, 0xa9f4b375d2718d9bULL,
+    0xe61e8dc4910be5abULL, 0x0510a0c99a6cc3d2ULL, 0x7ca4e07466b7fd9aULL, 0x14d94cdf9f1c9b86ULL,
+    0x3d6e103bc28c87d5ULL, 0x5e9cff088e285b6bULL, 0x036be51844a7383bULL, 0x8603d339e31d4598ULL,
+    0xf2811fd801248bccULL, 0x795fd798c6a033fdULL, 0x1e333c6151bdc59aULL, 0xa6cbc9ca6d1cc7f4ULL,
+    0x1f036b1134f28ff2ULL, 0x6653b10091d3a486ULL, 0xb969fdaaa106af7dULL, 0xa71a15a10189c27eULL,
+    0xd3ab68309cc5c204ULL, 0x08db1df07c13759aULL, 0x2c88d4672304d8c1ULL, 0x41d060e4bc670075ULL
+};
+
+static const uint64_t zobrist_white[SIZE * SIZE] = {
+    0x54df8fb56235575eULL, 0x218412e9c485bb1aULL, 0x602e2ebba504ea74ULL, 0x898cc97c1e76fe8bULL,
+    0x098c78dca3b53db7ULL, 0x800a8d8d312743bfULL, 0xcf3af1b1520026f9ULL, 0x788e5da9211ec8eeULL,
+    0xdfbc0495ac1c763fULL, 0xce00bf92a0ef631cULL, 0xf34d8f45ae1ff527ULL, 0x06d7f532e1cc56a7ULL,
+    0x793323fbc9c48eb3ULL, 0xbd19c36d4b998617ULL, 0x95d7e61e338f4717ULL, 0xbe239d1e645e44adULL,
+    0x5a2e0b38d0f72802ULL, 0x13f2afea3ca57b5fULL, 0xeb46df782afcd1f2ULL, 0x87c51bf892e1d61dULL,
+    0x689ed0d732b58bc4ULL, 0xd3ad0412c9f2658cULL, 0x878f44c1017544ffULL, 0x6947ec3bf57c6ec5ULL,
+    0x5528476af3b23d21ULL, 0xd091cb20f8ffc022ULL, 0xdb93738fc2d2c9a5ULL, 0xf38ec0da09772598ULL,
+    0x7be96a957ffebb55ULL, 0xd74b056da9bff702ULL, 0x4af207773d79a699ULL, 0x83189b0d64f45782ULL,
+    0xaa1e7445603d2624ULL, 0x1bb9750e013caf8bULL, 0x0340fbf80f1b9a90ULL, 0x6848094d20c70921ULL,
+    0x2991dc1f8d3f0589ULL, 0xe7c3fb62f5740deeULL, 0x70a36bfc2fbb9c08ULL, 0x4e30817f9d222659ULL,
+    0xcca9c109393229bdULL, 0x8a35b816a03e41d7ULL, 0x931e4d2067c2b0beULL, 0x6de06732add03f98ULL,
+    0x9b4d8c3dbad1d6d7ULL, 0x506bbcbecfb00507ULL, 0x659038077f0aed29ULL, 0x23bd8286eaa27e54ULL,
+    0xa72017207780baa8ULL, 0x454798c2100bde7cULL, 0x4e622fb523d6afb5ULL, 0xd56e7c5c1a41b2cdULL,
+    0x8b674b763489bc2eULL, 0xc8b3f6e5784c6ce1ULL, 0x7896a2a0357903a9ULL, 0x32577c7eb510ac8cULL,
+    0xbe394b3effdbec2eULL, 0x71ec3252b58320f8ULL, 0xbe67c47fd81cd70cULL, 0x4777bd782a525f64ULL,
+    0xae21c7addb81a339ULL, 0xccb935dd61db9ff9ULL, 0x5966666573673034ULL, 0xd709d5f31ecf1379ULL
+};
+
+static const uint64_t zobrist_side = 0x0bdf4b307a88cad1ULL;  // XORed in when white is to move
+
+// Kogge-Stone occluded fill: extend gen through runs of pro in one direction
+static inline uint64_t fill_left(uint64_t gen, uint64_t pro, int s) {
+    gen |= pro & (gen << s);
+    pro &= pro << s;
+    gen |= pro & (gen << (2 * s));
+    pro &= pro << (2 * s);
+    gen |= pro & (gen << (4 * s));
+    return gen;
+}
+
+static inline uint64_t fill_right(uint64_t gen, uint64_t pro, int s) {
+    gen |= pro & (gen >> s);
+    pro &= pro >> s;
+    gen |= pro & (gen >> (2 * s));
+    pro &= pro >> (2 * s);
+    gen |= pro & (gen >> (4 * s));
+    return gen;
+}
+
+static inline uint64_t own_stones(const GameState *state) {
+    return state->player == BLACK ? state->black : state->white;
+}
+
+static inline uint64_t opp_stones(const GameState *state) {
+    return state->player == BLACK ? state->white : state->black;
+}
 
 void init_board(GameState *state) {
-    memset(state->board, EMPTY, sizeof(state->board));
-    state->board[3][3] = WHITE;
-    state->board[3][4] = BLACK;
-    state->board[4][3] = BLACK;
-    state->board[4][4] = WHITE;
+    state->black = SQUARE_BIT(SQUARE(3, 4)) | SQUARE_BIT(SQUARE(4, 3));
+    state->white = SQUARE_BIT(SQUARE(3, 3)) | SQUARE_BIT(SQUARE(4, 4));
     state->player = BLACK;
+    state->hash = compute_hash(state);
 }
 
 int is_valid(int r, int c) {
@@ -20,71 +92,137 @@ int opponent(int player) {
     return player == BLACK ? WHITE : BLACK;
 }
 
+int get_cell(const GameState *state, int r, int c) {
+    uint64_t bit = SQUARE_BIT(SQUARE(r, c));
+    if (state->black & bit) return BLACK;
+    if (state->white & bit) return WHITE;
+    return EMPTY;
+}
+
+// Bitboard of every legal move for the player owning own
+uint64_t bitboard_moves(uint64_t own, uint64_t opp) {
+    uint64_t empty = ~(own | opp);
+    uint64_t moves = 0;
+
+    for (int d = 0; d < 4; d++) {
+        int s = dir_shift[d];
+        uint64_t run = fill_left(own, opp & left_mask[d], s) & opp;
+        moves |= (run << s) & left_mask[d] & empty;
+        run = fill_right(own, opp & right_mask[d], s) & opp;
+        moves |= (run >> s) & right_mask[d] & empty;
+    }
+    return moves;
+}
+
+// Bitboard of the opp stones flipped when own plays square sq (0 if illegal)
+uint64_t bitboard_flips(uint64_t own, uint64_t opp, int sq) {
+    uint64_t move = SQUARE_BIT(sq);
+    uint64_t flips = 0;
+
+    for (int d = 0; d < 4; d++) {
+        int s = dir_shift[d];
+        uint64_t run = fill_left(move, opp & left_mask[d], s);
+        if ((run << s) & left_mask[d] & own)
+            flips |= run & opp;
+        run = fill_right(move, opp & right_mask[d], s);
+        if ((run >> s) & right_mask[d] & own)
+            flips |= run & opp;
+    }
+    return flips;
+}
+
+// Bitboard of every legal move for the side to move
+uint64_t get_legal_moves(const GameState *state) {
+    return bitboard_moves(own_stones(state), opp_stones(state));
+}
+
+// Bitboard of the stones flipped by playing square sq (0 if the move is illegal)
+uint64_t get_flips(const GameState *state, int sq) {
+    return bitboard_flips(own_stones(state), opp_stones(state), sq);
+}
+
+// Fill moves with every legal move for the side to move; returns the count
+int generate_moves(const GameState *state, MoveList *moves) {
+    uint64_t mask = get_legal_moves(state);
+    moves->mask = mask;
+    moves->count = 0;
+    while (mask) {
+        moves->squares[moves->count++] = (unsigned char)__builtin_ctzll(mask);
+        mask &= mask - 1;
+    }
+    return moves->count;
+}
+
+// Like generate_moves, but if the side to move has no move the turn passes
+// to the opponent and their moves are generated instead. Returns 0 only when
+// neither side can move (game over).
+int generate_moves_or_pass(GameState *state, MoveList *moves) {
+    if (generate_moves(state, moves) > 0)
+        return moves->count;
+    pass_turn(state);
+    return generate_moves(state, moves);
+}
+
 int is_valid_move(GameState *state, int r, int c) {
-    if (!is_valid(r, c) || state->board[r][c] != EMPTY)
+    if (!is_valid(r, c))
         return 0;
-    
-    int opp = opponent(state->player);
-    for (int d = 0; d < 8; d++) {
-        int nr = r + dx[d], nc = c + dy[d];
-        int found_opp = 0;
-        
-        while (is_valid(nr, nc) && state->board[nr][nc] == opp) {
-            found_opp = 1;
-            nr += dx[d];
-            nc += dy[d];
-        }
-        
-        if (found_opp && is_valid(nr, nc) && state->board[nr][nc] == state->player)
-            return 1;
-    }
-    return 0;
+    int sq = SQUARE(r, c);
+    if ((state->black | state->white) & SQUARE_BIT(sq))
+        return 0;
+    return get_flips(state, sq) != 0;
 }
 
 int has_valid_moves(GameState *state) {
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++)
-            if (is_valid_move(state, i, j))
-                return 1;
-    return 0;
+    return get_legal_moves(state) != 0;
 }
 
 void make_move(GameState *state, int r, int c) {
-    state->board[r][c] = state->player;
-    int opp = opponent(state->player);
-    
-    for (int d = 0; d < 8; d++) {
-        int nr = r + dx[d], nc = c + dy[d];
-        int flips = 0;
-        
-        while (is_valid(nr, nc) && state->board[nr][nc] == opp) {
-            flips++;
-            nr += dx[d];
-            nc += dy[d];
-        }
-        
-        if (flips > 0 && is_valid(nr, nc) && state->board[nr][nc] == state->player) {
-            nr = r + dx[d];
-            nc = c + dy[d];
-            for (int i = 0; i < flips; i++) {
-                state->board[nr][nc] = state->player;
-                nr += dx[d];
-                nc += dy[d];
-            }
-        }
+    make_move_square(state, SQUARE(r, c));
+}
+
+void make_move_square(GameState *state, int sq) {
+    uint64_t flips = get_flips(state, sq);
+    uint64_t placed = SQUARE_BIT(sq) | flips;
+
+    uint64_t hash = state->hash ^ zobrist_side;
+
+    if (state->player == BLACK) {
+        state->black |= placed;
+        state->white ^= flips;
+        hash ^= zobrist_black[sq];
+    } else {
+        state->white |= placed;
+        state->black ^= flips;
+        hash ^= zobrist_white[sq];
+    }
+    for (; flips; flips &= flips - 1) {
+        int f = __builtin_ctzll(flips);
+        hash ^= zobrist_black[f] ^ zobrist_white[f];
     }
-    state->player = opp;
+
+    state->hash = hash;
+    state->player = opponent(state->player);
+}
+
+// Hand the move to the opponent without placing a stone
+void pass_turn(GameState *state) {
+    state->player = opponent(state->player);
+    state->hash ^= zobrist_side;
+}
+
+// Zobrist key of a position, computed from scratch
+uint64_t compute_hash(const GameState *state) {
+    uint64_t hash = state->player == WHITE ? zobrist_side : 0;
+    for (uint64_t b = state->black; b; b &= b - 1)
+        hash ^= zobrist_black[__builtin_ctzll(b)];
+    for (uint64_t w = state->white; w; w &= w - 1)
+        hash ^= zobrist_white[__builtin_ctzll(w)];
+    return hash;
 }
 
 void get_score(GameState *state, int *black, int *white) {
-    *black = 0;
-    *white = 0;
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            if (state->board[i][j] == BLACK) (*black)++;
-            else if (state->board[i][j] == WHITE) (*white)++;
-        }
-    }
+    *black = __builtin_popcountll(state->black);
+    *white = __builtin_popcountll(state->white);
 }
 
 int get_winner(GameState *state) {
@@ -97,14 +235,13 @@ GameState* clone_game_state(const GameState* original) {
     if (original == NULL) {
         return NULL;
     }
-    
+
     GameState* clone = (GameState*)malloc(sizeof(GameState));
     if (clone == NULL) {
         return NULL;  // Memory allocation failed
     }
-    
-    memcpy(clone->board, original->board, sizeof(original->board));
-    clone->player = original->player;
-    
+
+    *clone = *original;
+
     return clone;
 }
\ No newline at end of file
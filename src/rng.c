@@ -0,0 +1,19 @@
+#include "rng.h"
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Expand a 64-bit seed into a full generator state
+void rng_seed(RNG *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++)
+        rng->s[i] = splitmix64(&seed);
+}
+
+// Seed one of many independent streams from a shared seed, e.g. one per thread
+void rng_seed_stream(RNG *rng, uint64_t seed, uint64_t stream) {
+    rng_seed(rng, seed ^ splitmix64(&stream));
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "task_pool.h"
+
+#define TASK_DEQUE_MASK (TASK_DEQUE_SIZE - 1)
+#define TASK_STACK_BATCH 64     // Batches up to this size keep their tasks on the stack
+
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax() __builtin_ia32_pause()
+#else
+#define cpu_relax() ((void)0)
+#endif
+
+// Which pool (if any) the current thread works for, and as which worker
+static _Thread_local TaskPool *current_pool = NULL;
+static _Thread_local int current_worker = -1;
+
+typedef struct {
+    TaskPool *pool;
+    int worker;
+} WorkerArgs;
+
+// DEQUE OPERATIONS
+
+// Owner only. Returns 0 when the deque is full.
+static int deque_push(TaskDeque *d, Task *task) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    if (b - t >= TASK_DEQUE_SIZE) return 0;
+    __atomic_store_n(&d->tasks[b & TASK_DEQUE_MASK], task, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// Owner only; newest task first
+static Task* deque_take(TaskDeque *d) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+
+    Task *task = NULL;
+    if (t <= b) {
+        task = __atomic_load_n(&d->tasks[b & TASK_DEQUE_MASK], __ATOMIC_RELAXED);
+        if (t == b) {
+            // Last task: race thieves for it
+            if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0,
+                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+                task = NULL;
+            __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return task;
+}
+
+// Any thread; oldest task first
+static Task* deque_steal(TaskDeque *d) {
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b) return NULL;
+
+    Task *task = __atomic_load_n(&d->tasks[t & TASK_DEQUE_MASK], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return NULL;
+    return task;
+}
+
+// SCHEDULING
+
+static void run_task(TaskPool *pool, Task *task, int worker) {
+    int external = task->external;
+    int *pending = task->pending;
+    task->fn(task->arg, task->index, worker);
+    if (__atomic_sub_fetch(pending, 1, __ATOMIC_ACQ_REL) == 0 && external) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+// Wake sleeping workers after publishing work. Pairs with the check in
+// worker_sleep: either the sleeper sees the new epoch, or we see it waiting.
+static void notify_workers(TaskPool *pool) {
+    __atomic_add_fetch(&pool->epoch, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool->sleepers, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static Task* take_injected(TaskPool *pool) {
+    if (__atomic_load_n(&pool->injected, __ATOMIC_RELAXED) == NULL) return NULL;
+    pthread_mutex_lock(&pool->lock);
+    Task *task = pool->injected;
+    if (task != NULL) __atomic_store_n(&pool->injected, task->next, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pool->lock);
+    return task;
+}
+
+// Own deque first, then the other workers' oldest tasks, then (if allowed)
+// outside work
+static Task* find_task(TaskPool *pool, int worker, int outside) {
+    Task *task = deque_take(&pool->deques[worker]);
+    if (task != NULL) return task;
+
+    for (int i = 1; i < pool->num_workers; i++) {
+        task = deque_steal(&pool->deques[(worker + i) % pool->num_workers]);
+        if (task != NULL) return task;
+    }
+    return outside ? take_injected(pool) : NULL;
+}
+
+static void worker_sleep(TaskPool *pool, uint64_t seen_epoch) {
+    pthread_mutex_lock(&pool->lock);
+    __atomic_add_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&pool->epoch, __ATOMIC_SEQ_CST) == seen_epoch && !pool->shutdown)
+        pthread_cond_wait(&pool->wake, &pool->lock);
+    __atomic_sub_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void* worker_main(void *p) {
+    WorkerArgs args = *(WorkerArgs *)p;
+    free(p);
+    TaskPool *pool = args.pool;
+    current_pool = pool;
+    current_worker = args.worker;
+
+    int idle = 0;
+    uint64_t seen_epoch = __atomic_load_n(&pool->epoch, __ATOMIC_SEQ_CST);
+    while (!__atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE)) {
+        Task *task = find_task(pool, args.worker, 1);
+        if (task != NULL) {
+            run_task(pool, task, args.worker);
+            idle = 0;
+            continue;
+        }
+
+        // Spin briefly so back-to-back batches start without a wakeup
+        if (++idle < pool->spin_rounds) {
+            uint64_t epoch = __atomic_load_n(&pool->epoch, __ATOMIC_SEQ_CST);
+            if (epoch != seen_epoch) {
+                seen_epoch = epoch;
+                idle = 0;
+            }
+            cpu_relax();
+            continue;
+        }
+        worker_sleep(pool, seen_epoch);
+        seen_epoch = __atomic_load_n(&pool->epoch, __ATOMIC_SEQ_CST);
+        idle = 0;
+    }
+    return NULL;
+}
+
+// POOL FUNCTIONS
+
+// Start num_workers worker threads. Returns 0 on failure.
+int task_pool_init(TaskPool *pool, int num_workers) {
+    if (num_workers < 1) num_workers = 1;
+    pool->num_workers = num_workers;
+    pool->injected = NULL;
+    pool->sleepers = 0;
+    pool->epoch = 0;
+    pool->shutdown = 0;
+
+    // Spinning only helps when every worker (and the submitter) has a core;
+    // otherwise it steals time from the thread doing the work
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    pool->spin_rounds = num_workers < cores ? TASK_SPIN_ROUNDS : 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    pool->deques = aligned_alloc(64, num_workers * sizeof(TaskDeque));
+    pool->threads = malloc(num_workers * sizeof(pthread_t));
+    if (pool->deques == NULL || pool->threads == NULL) return 0;
+    for (int i = 0; i < num_workers; i++) {
+        pool->deques[i].top = 0;
+        pool->deques[i].bottom = 0;
+    }
+
+    for (int i = 0; i < num_workers; i++) {
+        WorkerArgs *args = malloc(sizeof(WorkerArgs));
+        if (args == NULL) {
+            pool->num_workers = i;
+            break;
+        }
+        args->pool = pool;
+        args->worker = i;
+        if (pthread_create(&pool->threads[i], NULL, worker_main, args) != 0) {
+            free(args);
+            pool->num_workers = i;
+            break;
+        }
+    }
+    return pool->num_workers > 0;
+}
+
+void task_pool_destroy(TaskPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    __atomic_store_n(&pool->shutdown, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->num_workers; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->done);
+    free(pool->deques);
+    free(pool->threads);
+    pool->deques = NULL;
+    pool->threads = NULL;
+    pool->num_workers = 0;
+}
+
+int task_pool_size(const TaskPool *pool) {
+    return pool->num_workers;
+}
+
+// Run fn(arg, i, worker) for i in [0, count) and return once all are done.
+// Called from inside a task, the batch goes on that worker's deque and the
+// caller keeps executing tasks while it waits, so nested batches cannot
+// deadlock. Any other thread queues the batch centrally and sleeps.
+void task_pool_run(TaskPool *pool, TaskFn fn, void *arg, int count) {
+    if (count <= 0) return;
+
+    Task stack_tasks[TASK_STACK_BATCH];
+    Task *tasks = count <= TASK_STACK_BATCH ? stack_tasks : malloc(count * sizeof(Task));
+    int pending = count;
+    int worker = current_pool == pool ? current_worker : -1;
+
+    for (int i = 0; i < count; i++) {
+        tasks[i].fn = fn;
+        tasks[i].arg = arg;
+        tasks[i].index = i;
+        tasks[i].pending = &pending;
+        tasks[i].external = worker < 0;
+        tasks[i].next = NULL;
+    }
+
+    if (worker >= 0) {
+        // Push in reverse so the owner takes task 0 first
+        for (int i = count - 1; i >= 1; i--) {
+            if (!deque_push(&pool->deques[worker], &tasks[i]))
+                run_task(pool, &tasks[i], worker);
+        }
+        notify_workers(pool);
+        run_task(pool, &tasks[0], worker);
+
+        // Help with other batches' tasks while waiting, but never start
+        // new outside work: a long top-level task picked up here would hold
+        // this batch's caller until it finished
+        while (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) > 0) {
+            Task *task = find_task(pool, worker, 0);
+            if (task != NULL) run_task(pool, task, worker);
+            else cpu_relax();
+        }
+    } else {
+        pthread_mutex_lock(&pool->lock);
+        for (int i = count - 1; i >= 0; i--) {
+            tasks[i].next = pool->injected;
+            __atomic_store_n(&pool->injected, &tasks[i], __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&pool->lock);
+        notify_workers(pool);
+
+        for (int spin = 0; spin < pool->spin_rounds; spin++) {
+            if (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) == 0) break;
+            cpu_relax();
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) > 0)
+            pthread_cond_wait(&pool->done, &pool->lock);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    if (tasks != stack_tasks) free(tasks);
+}
\ No newline at end of file
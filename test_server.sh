@@ -0,0 +1,65 @@
+#!/bin/sh
+# Starts mcts_server on a temporary socket, drives one session through
+# mcts_client and checks that every reply starts as expected. Run with
+# `make test-server`; exits non-zero on the first broken reply.
+
+SERVER=./mcts_server
+CLIENT=./mcts_client
+DIR=$(mktemp -d) || exit 1
+SOCK=$DIR/mcts.sock
+
+$SERVER --socket "$SOCK" --threads 2 --seed 1 > "$DIR/server.log" 2>&1 &
+PID=$!
+trap 'kill $PID 2>/dev/null; rm -rf "$DIR"' EXIT
+
+# Wait for the server to listen
+tries=0
+while [ ! -S "$SOCK" ]; do
+    tries=$((tries + 1))
+    if [ $tries -gt 50 ] || ! kill -0 $PID 2>/dev/null; then
+        echo "FAIL: server did not open $SOCK"
+        cat "$DIR/server.log"
+        exit 1
+    fi
+    sleep 0.1
+done
+
+# Each command of the session and the prefix its reply must start with
+CASES='newgame|ok newgame
+position startpos|ok position
+go iterations 2000|bestmove
+stop|ok stop
+stats|ok stats searches=1 playouts=2000
+play d3|ok play
+go iterations 500|bestmove
+position nonsense|error position
+quit|ok quit'
+
+printf '%s\n' "$CASES" | cut -d'|' -f1 | $CLIENT "$SOCK" > "$DIR/replies" 2> /dev/null
+
+status=0
+n=0
+while IFS='|' read -r command expected; do
+    n=$((n + 1))
+    reply=$(sed -n "${n}p" "$DIR/replies")
+    case $reply in
+        "$expected"*) echo "ok   $command" ;;
+        *) echo "FAIL $command: got '$reply'"; status=1 ;;
+    esac
+done <<EOF
+$CASES
+EOF
+
+# quit must shut the server down
+tries=0
+while kill -0 $PID 2>/dev/null; do
+    tries=$((tries + 1))
+    if [ $tries -gt 50 ]; then
+        echo "FAIL quit: server still running"
+        exit 1
+    fi
+    sleep 0.1
+done
+
+[ $status -eq 0 ] && echo "Server test passed"
+exit $status
\ No newline at end of file